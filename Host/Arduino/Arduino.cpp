@@ -0,0 +1,135 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Arduino.h"
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <thread>
+
+static const std::chrono::steady_clock::time_point ARDUINO_START = std::chrono::steady_clock::now();
+static std::atomic<unsigned long> _advanced(0);
+
+HardwareSerial Serial;
+
+unsigned long millis()
+{
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - ARDUINO_START).count() + _advanced;
+}
+
+unsigned long micros()
+{
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ARDUINO_START).count() + (_advanced * 1000UL);
+}
+
+void advanceTime(unsigned long ms)
+{
+  _advanced += ms;
+}
+
+void delay(unsigned long ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+  size_t returnValue = 0;
+
+  for (size_t i = 0; i < size; i++)
+  {
+    returnValue += this->write(buffer[i]);
+  }
+
+  return returnValue;
+}
+
+size_t Print::write(const char* text)
+{
+  return text == NULL ? 0 : this->write((const uint8_t*)text, strlen(text));
+}
+
+size_t Print::format(const char* format, ...)
+{
+  char buffer[64];
+  va_list arguments;
+
+  va_start(arguments, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, arguments);
+  va_end(arguments);
+
+  return length > 0 ? this->write((const uint8_t*)buffer, min((size_t)length, sizeof(buffer) - 1)) : 0;
+}
+
+size_t Print::print(const char* text) { return this->write(text); }
+size_t Print::print(char value) { return this->write((uint8_t)value); }
+size_t Print::print(int value) { return this->format("%d", value); }
+size_t Print::print(unsigned int value) { return this->format("%u", value); }
+size_t Print::print(long value) { return this->format("%ld", value); }
+size_t Print::print(unsigned long value) { return this->format("%lu", value); }
+size_t Print::print(double value, int digits) { return this->format("%.*f", digits, value); }
+size_t Print::println() { return this->write("\r\n"); }
+size_t Print::println(const char* text) { return this->print(text) + this->println(); }
+size_t Print::println(char value) { return this->print(value) + this->println(); }
+size_t Print::println(int value) { return this->print(value) + this->println(); }
+size_t Print::println(unsigned int value) { return this->print(value) + this->println(); }
+size_t Print::println(long value) { return this->print(value) + this->println(); }
+size_t Print::println(unsigned long value) { return this->print(value) + this->println(); }
+size_t Print::println(double value, int digits) { return this->print(value, digits) + this->println(); }
+
+void HardwareSerial::begin(unsigned long)
+{
+}
+
+size_t HardwareSerial::write(uint8_t value)
+{
+  return this->write(&value, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size)
+{
+  if (this->echo)
+  {
+    fwrite(buffer, 1, size, stderr);
+  }
+
+  return size;
+}
+
+int HardwareSerial::available()
+{
+  return 0;
+}
+
+int HardwareSerial::read()
+{
+  return -1;
+}
+
+int HardwareSerial::peek()
+{
+  return -1;
+}
@@ -0,0 +1,148 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+//
+// The subset of the Arduino core used by the sketch, implemented
+// on the host (Linux, macOS) so that everything except led.ino can
+// be built, tested and benchmarked without hardware. ARDUINO is not
+// defined so the host-only code in the sketch is compiled.
+//
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define pgm_read_byte(address)      (*(const uint8_t*)(address))
+#define pgm_read_word(address)      (*(const uint16_t*)(address))
+#define pgm_read_dword(address)     (*(const uint32_t*)(address))
+
+#ifndef PI
+#define PI                          3.1415926535897932384626433832795
+#endif
+
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+
+using std::min;
+using std::max;
+using std::abs;
+
+//
+// Time since the program started.
+//
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+//
+// Host only: moves millis() and micros() forward without
+// waiting so tests can cover long periods quickly.
+//
+void advanceTime(unsigned long ms);
+
+//
+// There are no interrupts on the host.
+//
+inline void noInterrupts()
+{
+}
+
+inline void interrupts()
+{
+}
+
+//
+// Formats values and writes them one byte at a time.
+//
+class Print
+{
+  public:
+    virtual ~Print()
+    {
+    }
+
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+
+    size_t write(const char* text);
+    size_t print(const char* text);
+    size_t print(char value);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int digits = 2);
+    size_t println();
+    size_t println(const char* text);
+    size_t println(char value);
+    size_t println(int value);
+    size_t println(unsigned int value);
+    size_t println(long value);
+    size_t println(unsigned long value);
+    size_t println(double value, int digits = 2);
+
+  protected:
+    size_t format(const char* format, ...);
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+//
+// The serial port. Output is discarded unless echo is set, in
+// which case it is written to stderr; nothing is ever received.
+//
+class HardwareSerial : public Stream
+{
+  public:
+    void begin(unsigned long baud);
+
+    size_t write(uint8_t value);
+    size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+
+    int available();
+    int read();
+    int peek();
+
+    operator bool()
+    {
+      return true;
+    }
+
+    bool echo = false;
+};
+
+extern HardwareSerial Serial;
+#endif
@@ -0,0 +1,80 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include "Arduino.h"
+
+//
+// The size of the emulated EEPROM (an ATmega328P has 1 KB).
+//
+#ifndef EEPROM_SIZE
+#define EEPROM_SIZE     1024
+#endif
+
+//
+// EEPROM emulated in memory. It starts erased (0xFF) and counts
+// the writes to each cell so wear can be measured.
+//
+class EEPROMClass
+{
+  public:
+    EEPROMClass()
+    {
+      memset(this->_data, 0xFF, sizeof(this->_data));
+      memset(this->writes, 0, sizeof(this->writes));
+    }
+
+    uint8_t read(int address)
+    {
+      return this->_data[address];
+    }
+
+    void write(int address, uint8_t value)
+    {
+      this->_data[address] = value;
+      this->writes[address]++;
+    }
+
+    void update(int address, uint8_t value)
+    {
+      if (this->_data[address] != value)
+      {
+        this->write(address, value);
+      }
+    }
+
+    uint16_t length()
+    {
+      return EEPROM_SIZE;
+    }
+
+    //
+    // The number of times each cell has been written.
+    //
+    uint32_t writes[EEPROM_SIZE];
+
+  protected:
+    uint8_t _data[EEPROM_SIZE];
+};
+
+extern EEPROMClass EEPROM;
+#endif
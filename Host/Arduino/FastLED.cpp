@@ -0,0 +1,52 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "FastLED.h"
+
+uint16_t rand16seed = 1337;
+CFastLED FastLED;
+
+CRGB::CRGB(const CHSV& hsv)
+{
+  hsv2rgb_spectrum(hsv, *this);
+}
+
+void hsv2rgb_spectrum(const CHSV& hsv, CRGB& rgb)
+{
+  //
+  // Six sectors of 43 steps around the wheel.
+  //
+  uint8_t sector = hsv.h / 43;
+  uint8_t remainder = (uint8_t)((hsv.h - (sector * 43)) * 6);
+
+  uint8_t p = scale8(hsv.v, 255 - hsv.s);
+  uint8_t q = scale8(hsv.v, 255 - scale8(hsv.s, remainder));
+  uint8_t t = scale8(hsv.v, 255 - scale8(hsv.s, 255 - remainder));
+
+  switch (sector)
+  {
+    case 0: rgb = CRGB(hsv.v, t, p); break;
+    case 1: rgb = CRGB(q, hsv.v, p); break;
+    case 2: rgb = CRGB(p, hsv.v, t); break;
+    case 3: rgb = CRGB(p, q, hsv.v); break;
+    case 4: rgb = CRGB(t, p, hsv.v); break;
+    default: rgb = CRGB(hsv.v, p, q); break;
+  }
+}
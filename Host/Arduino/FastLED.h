@@ -0,0 +1,269 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef FASTLED_H
+#define FASTLED_H
+
+//
+// The subset of FastLED used by the sketch, for the host build. The
+// integer functions follow FastLED's C implementations so effects
+// draw the same values; CHSV is converted with a plain six-sector
+// conversion rather than FastLED's rainbow, so colors from CHSV
+// differ slightly from the hardware.
+//
+#include "Arduino.h"
+
+typedef uint8_t fract8;
+
+//
+// lib8tion.
+//
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+  unsigned int t = i + j;
+  return t > 255 ? 255 : (uint8_t)t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j)
+{
+  int t = i - j;
+  return t < 0 ? 0 : (uint8_t)t;
+}
+
+inline uint8_t scale8(uint8_t i, fract8 scale)
+{
+  return (uint8_t)(((uint16_t)i * (1 + (uint16_t)scale)) >> 8);
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale)
+{
+  return (uint8_t)((((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0));
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB)
+{
+  uint16_t partial = (uint16_t)((a << 8) | b);
+  partial += (uint16_t)(b * amountOfB);
+  partial -= (uint16_t)(a * amountOfB);
+  return (uint8_t)(partial >> 8);
+}
+
+inline uint8_t sqrt16(uint16_t x)
+{
+  if (x <= 1)
+  {
+    return (uint8_t)x;
+  }
+
+  uint8_t low = 1;
+  uint8_t high = x > 7904 ? 255 : (uint8_t)((x >> 5) + 8);
+  uint8_t mid;
+
+  do
+  {
+    mid = (low + high) >> 1;
+
+    if ((uint16_t)(mid * mid) > x)
+    {
+      high = mid - 1;
+    }
+    else
+    {
+      if (mid == 255)
+      {
+        return 255;
+      }
+
+      low = mid + 1;
+    }
+  }
+  while (high >= low);
+
+  return low - 1;
+}
+
+//
+// FastLED's 16-bit linear congruential generator.
+//
+extern uint16_t rand16seed;
+
+inline uint16_t random16()
+{
+  rand16seed = (uint16_t)((rand16seed * (uint16_t)2053) + (uint16_t)13849);
+  return rand16seed;
+}
+
+inline uint16_t random16(uint16_t limit)
+{
+  return (uint16_t)(((uint32_t)random16() * limit) >> 16);
+}
+
+inline uint8_t random8()
+{
+  rand16seed = (uint16_t)((rand16seed * (uint16_t)2053) + (uint16_t)13849);
+  return (uint8_t)((uint8_t)(rand16seed & 0xFF) + (uint8_t)(rand16seed >> 8));
+}
+
+inline uint8_t random8(uint8_t limit)
+{
+  return (uint8_t)(((uint16_t)random8() * limit) >> 8);
+}
+
+inline void random16_set_seed(uint16_t seed)
+{
+  rand16seed = seed;
+}
+
+struct CHSV
+{
+  uint8_t h;
+  uint8_t s;
+  uint8_t v;
+
+  inline CHSV()
+  {
+  }
+
+  inline CHSV(uint8_t h, uint8_t s, uint8_t v) : h(h), s(s), v(v)
+  {
+  }
+};
+
+struct CRGB
+{
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+
+  enum HTMLColorCode
+  {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Green = 0x008000,
+    Red = 0xFF0000,
+    White = 0xFFFFFF
+  };
+
+  //
+  // Like FastLED the default constructor does not initialize
+  // the color.
+  //
+  inline CRGB()
+  {
+  }
+
+  inline CRGB(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b)
+  {
+  }
+
+  inline CRGB(uint32_t colorCode) : r((uint8_t)(colorCode >> 16)), g((uint8_t)(colorCode >> 8)), b((uint8_t)colorCode)
+  {
+  }
+
+  inline CRGB(HTMLColorCode colorCode) : CRGB((uint32_t)colorCode)
+  {
+  }
+
+  CRGB(const CHSV& hsv);
+
+  inline uint8_t& operator[](uint8_t index)
+  {
+    return (&this->r)[index];
+  }
+
+  inline const uint8_t& operator[](uint8_t index) const
+  {
+    return (&this->r)[index];
+  }
+
+  inline CRGB& operator+=(const CRGB& rgb)
+  {
+    this->r = qadd8(this->r, rgb.r);
+    this->g = qadd8(this->g, rgb.g);
+    this->b = qadd8(this->b, rgb.b);
+    return *this;
+  }
+
+  inline CRGB& nscale8(uint8_t scale)
+  {
+    this->r = scale8(this->r, scale);
+    this->g = scale8(this->g, scale);
+    this->b = scale8(this->b, scale);
+    return *this;
+  }
+
+  inline CRGB& fadeToBlackBy(uint8_t fade)
+  {
+    return this->nscale8(255 - fade);
+  }
+
+  inline bool operator==(const CRGB& rgb) const
+  {
+    return this->r == rgb.r && this->g == rgb.g && this->b == rgb.b;
+  }
+
+  inline bool operator!=(const CRGB& rgb) const
+  {
+    return !(*this == rgb);
+  }
+};
+
+static_assert(sizeof(CRGB) == 3, "CRGB must be three packed channels.");
+
+void hsv2rgb_spectrum(const CHSV& hsv, CRGB& rgb);
+
+inline CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2)
+{
+  return CRGB(blend8(p1.r, p2.r, amountOfP2), blend8(p1.g, p2.g, amountOfP2), blend8(p1.b, p2.b, amountOfP2));
+}
+
+//
+// There are no strips on the host; show() only counts.
+//
+class CFastLED
+{
+  public:
+    void show()
+    {
+      this->frames++;
+    }
+
+    void clear()
+    {
+    }
+
+    void setBrightness(uint8_t brightness)
+    {
+      this->_brightness = brightness;
+    }
+
+    uint8_t getBrightness()
+    {
+      return this->_brightness;
+    }
+
+    uint32_t frames = 0;
+
+  protected:
+    uint8_t _brightness = 255;
+};
+
+extern CFastLED FastLED;
+#endif
@@ -0,0 +1,191 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "HostUdp.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static sockaddr_in hostUdpAddress(IPAddress address, uint16_t port)
+{
+  sockaddr_in returnValue;
+  memset(&returnValue, 0, sizeof(returnValue));
+  returnValue.sin_family = AF_INET;
+  returnValue.sin_port = htons(port);
+  memcpy(&returnValue.sin_addr.s_addr, &address[0], 4);
+
+  return returnValue;
+}
+
+HostUdp::~HostUdp()
+{
+  this->stop();
+}
+
+bool HostUdp::open()
+{
+  if (this->_socket < 0)
+  {
+    this->_socket = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (this->_socket >= 0)
+    {
+      int enable = 1;
+      setsockopt(this->_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#ifdef SO_REUSEPORT
+      setsockopt(this->_socket, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+#endif
+      setsockopt(this->_socket, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+      fcntl(this->_socket, F_SETFL, fcntl(this->_socket, F_GETFL) | O_NONBLOCK);
+    }
+  }
+
+  return this->_socket >= 0;
+}
+
+uint8_t HostUdp::begin(uint16_t port)
+{
+  uint8_t returnValue = 0;
+
+  if (this->open())
+  {
+    sockaddr_in address = hostUdpAddress(IPAddress(0, 0, 0, 0), port);
+    returnValue = bind(this->_socket, (sockaddr*)&address, sizeof(address)) == 0 ? 1 : 0;
+  }
+
+  return returnValue;
+}
+
+uint8_t HostUdp::beginMulticast(IPAddress group, uint16_t port)
+{
+  uint8_t returnValue = this->begin(port);
+
+  if (returnValue)
+  {
+    ip_mreq request;
+    memset(&request, 0, sizeof(request));
+    memcpy(&request.imr_multiaddr.s_addr, &group[0], 4);
+    request.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    returnValue = setsockopt(this->_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request)) == 0 ? 1 : 0;
+  }
+
+  return returnValue;
+}
+
+void HostUdp::stop()
+{
+  if (this->_socket >= 0)
+  {
+    close(this->_socket);
+    this->_socket = -1;
+  }
+}
+
+int HostUdp::beginPacket(IPAddress address, uint16_t port)
+{
+  this->_address = address;
+  this->_port = port;
+  this->_output.clear();
+
+  return this->open() ? 1 : 0;
+}
+
+int HostUdp::endPacket()
+{
+  sockaddr_in address = hostUdpAddress(this->_address, this->_port);
+  ssize_t sent = sendto(this->_socket, this->_output.data(), this->_output.size(), 0, (sockaddr*)&address, sizeof(address));
+
+  return sent == (ssize_t)this->_output.size() ? 1 : 0;
+}
+
+size_t HostUdp::write(uint8_t value)
+{
+  this->_output.push_back(value);
+  return 1;
+}
+
+size_t HostUdp::write(const uint8_t* buffer, size_t size)
+{
+  this->_output.insert(this->_output.end(), buffer, buffer + size);
+  return size;
+}
+
+int HostUdp::parsePacket()
+{
+  int returnValue = 0;
+
+  this->_inputLength = 0;
+  this->_inputPosition = 0;
+
+  if (this->_socket >= 0)
+  {
+    sockaddr_in address;
+    socklen_t length = sizeof(address);
+    ssize_t received = recvfrom(this->_socket, this->_input, sizeof(this->_input), 0, (sockaddr*)&address, &length);
+
+    if (received > 0)
+    {
+      memcpy(&this->_remoteAddress[0], &address.sin_addr.s_addr, 4);
+      this->_remotePort = ntohs(address.sin_port);
+      this->_inputLength = (size_t)received;
+      returnValue = (int)received;
+    }
+  }
+
+  return returnValue;
+}
+
+int HostUdp::available()
+{
+  return (int)(this->_inputLength - this->_inputPosition);
+}
+
+int HostUdp::read()
+{
+  return this->_inputPosition < this->_inputLength ? this->_input[this->_inputPosition++] : -1;
+}
+
+int HostUdp::read(unsigned char* buffer, size_t length)
+{
+  size_t count = min(length, this->_inputLength - this->_inputPosition);
+
+  memcpy(buffer, &this->_input[this->_inputPosition], count);
+  this->_inputPosition += count;
+
+  return (int)count;
+}
+
+int HostUdp::peek()
+{
+  return this->_inputPosition < this->_inputLength ? this->_input[this->_inputPosition] : -1;
+}
+
+IPAddress HostUdp::remoteIP()
+{
+  return this->_remoteAddress;
+}
+
+uint16_t HostUdp::remotePort()
+{
+  return this->_remotePort;
+}
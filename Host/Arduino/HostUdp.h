@@ -0,0 +1,70 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef HOST_UDP_H
+#define HOST_UDP_H
+
+#include <vector>
+#include "Udp.h"
+
+//
+// UDP over a non-blocking BSD socket for the host build.
+//
+class HostUdp : public UDP
+{
+  public:
+    ~HostUdp();
+
+    uint8_t begin(uint16_t port);
+    uint8_t beginMulticast(IPAddress address, uint16_t port);
+    void stop();
+
+    int beginPacket(IPAddress address, uint16_t port);
+    int endPacket();
+    size_t write(uint8_t value);
+    size_t write(const uint8_t* buffer, size_t size);
+
+    int parsePacket();
+    int available();
+    int read();
+    int read(unsigned char* buffer, size_t length);
+    int peek();
+    IPAddress remoteIP();
+    uint16_t remotePort();
+
+  protected:
+    //
+    // Opens the socket if it is not already open.
+    //
+    bool open();
+
+    int _socket = -1;
+
+    IPAddress _address;
+    uint16_t _port = 0;
+    std::vector<uint8_t> _output;
+
+    IPAddress _remoteAddress;
+    uint16_t _remotePort = 0;
+    uint8_t _input[1500];
+    size_t _inputLength = 0;
+    size_t _inputPosition = 0;
+};
+#endif
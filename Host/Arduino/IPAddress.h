@@ -0,0 +1,68 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef IP_ADDRESS_H
+#define IP_ADDRESS_H
+
+#include "Arduino.h"
+
+//
+// An IPv4 address stored in network order.
+//
+class IPAddress
+{
+  public:
+    IPAddress()
+    {
+      memset(this->_address, 0, sizeof(this->_address));
+    }
+
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    {
+      this->_address[0] = a;
+      this->_address[1] = b;
+      this->_address[2] = c;
+      this->_address[3] = d;
+    }
+
+    uint8_t operator[](int index) const
+    {
+      return this->_address[index];
+    }
+
+    uint8_t& operator[](int index)
+    {
+      return this->_address[index];
+    }
+
+    bool operator==(const IPAddress& address) const
+    {
+      return memcmp(this->_address, address._address, sizeof(this->_address)) == 0;
+    }
+
+    bool operator!=(const IPAddress& address) const
+    {
+      return !(*this == address);
+    }
+
+  protected:
+    uint8_t _address[4];
+};
+#endif
@@ -0,0 +1,50 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef UDP_H
+#define UDP_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+//
+// The Arduino UDP interface implemented by WiFiUDP, EthernetUDP
+// and, on the host, HostUdp.
+//
+class UDP : public Stream
+{
+  public:
+    virtual uint8_t begin(uint16_t port) = 0;
+    virtual uint8_t beginMulticast(IPAddress address, uint16_t port) = 0;
+    virtual void stop() = 0;
+
+    virtual int beginPacket(IPAddress address, uint16_t port) = 0;
+    virtual int endPacket() = 0;
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+
+    virtual int parsePacket() = 0;
+    virtual int read(unsigned char* buffer, size_t length) = 0;
+    virtual IPAddress remoteIP() = 0;
+    virtual uint16_t remotePort() = 0;
+
+    using Stream::read;
+};
+#endif
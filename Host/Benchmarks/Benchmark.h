@@ -0,0 +1,97 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//
+// Helpers shared by the benchmarks.
+//
+class Benchmark
+{
+  public:
+    //
+    // Returns true if --quick was passed; ctest runs each benchmark
+    // this way so they are kept working without taking long.
+    //
+    static bool quick(int argc, char** argv)
+    {
+      bool returnValue = false;
+
+      for (int i = 1; i < argc; i++)
+      {
+        returnValue = returnValue || strcmp(argv[i], "--quick") == 0;
+      }
+
+      return returnValue;
+    }
+
+    //
+    // Returns the value following an option such as --threads,
+    // or the default if it was not passed.
+    //
+    static long option(int argc, char** argv, const char* name, long value)
+    {
+      for (int i = 1; i + 1 < argc; i++)
+      {
+        if (strcmp(argv[i], name) == 0)
+        {
+          value = strtol(argv[i + 1], NULL, 10);
+        }
+      }
+
+      return value;
+    }
+
+    //
+    // Starts timing.
+    //
+    void start()
+    {
+      this->_start = std::chrono::steady_clock::now();
+    }
+
+    //
+    // Returns the ns since start().
+    //
+    double elapsed()
+    {
+      return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->_start).count();
+    }
+
+  protected:
+    std::chrono::steady_clock::time_point _start;
+};
+
+//
+// Keeps the compiler from removing a calculation whose
+// result is not otherwise used.
+//
+template <typename T>
+inline void benchmarkKeep(const T& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+#endif
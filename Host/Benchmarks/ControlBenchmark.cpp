@@ -0,0 +1,213 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include "Benchmark.h"
+#include "ControlClient.h"
+#include "ControlPort.h"
+
+//
+// A Stream over the master side of a pseudo-terminal; it stands
+// in for the serial port of the sketch.
+//
+class PtyStream : public Stream
+{
+  public:
+    PtyStream(int fd)
+    {
+      this->_fd = fd;
+    }
+
+    int available()
+    {
+      this->fill();
+      return this->_length - this->_position;
+    }
+
+    int read()
+    {
+      int returnValue = this->peek();
+
+      if (returnValue >= 0)
+      {
+        this->_position++;
+      }
+
+      return returnValue;
+    }
+
+    int peek()
+    {
+      this->fill();
+      return this->_position < this->_length ? this->_buffer[this->_position] : -1;
+    }
+
+    size_t write(uint8_t value)
+    {
+      return ::write(this->_fd, &value, 1) == 1 ? 1 : 0;
+    }
+
+  protected:
+    void fill()
+    {
+      if (this->_position == this->_length)
+      {
+        ssize_t result = ::read(this->_fd, this->_buffer, sizeof(this->_buffer));
+        this->_position = 0;
+        this->_length = result > 0 ? (int)result : 0;
+      }
+    }
+
+    int _fd;
+    uint8_t _buffer[4096];
+    int _position = 0;
+    int _length = 0;
+};
+
+//
+// What the command handler received.
+//
+static uint32_t _ledsReceived = 0;
+static uint32_t _shows = 0;
+static uint32_t _mismatches = 0;
+
+static void handleCommand(uint8_t command, const uint8_t* payload, uint16_t length)
+{
+  if (command == CONTROL_FRAME)
+  {
+    uint16_t first = (uint16_t)payload[0] | ((uint16_t)payload[1] << 8);
+
+    for (uint16_t i = 2; i + 2 < length; i += 3, first++)
+    {
+      //
+      // The client sends LED i of frame f as (i, f, i + f).
+      //
+      uint8_t expected = (uint8_t)first;
+      _mismatches += (payload[i] != expected || (uint8_t)(payload[i + 2] - payload[i + 1]) != expected) ? 1 : 0;
+      _ledsReceived++;
+    }
+  }
+  else if (command == CONTROL_SHOW)
+  {
+    _shows++;
+  }
+}
+
+//
+// Streams frames from a ControlClient to a ControlPort through a
+// pseudo-terminal, then pings, and reports the throughput. Every
+// frame must arrive intact. A pseudo-terminal is not limited by a
+// baud rate so this measures the encoding and decoding, not the
+// serial link.
+//
+//  --frames N      The number of frames streamed (default 2000).
+//  --leds N        The number of LEDs per frame (default 300).
+//
+int main(int argc, char** argv)
+{
+  bool quick = Benchmark::quick(argc, argv);
+  long frames = Benchmark::option(argc, argv, "--frames", quick ? 20 : 2000);
+  long numberOfLeds = Benchmark::option(argc, argv, "--leds", 300);
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+  {
+    fprintf(stderr, "No pseudo-terminal available.\n");
+    return 1;
+  }
+
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+  //
+  // The master is put in raw mode too so nothing the sketch
+  // side writes is translated.
+  //
+  struct termios options;
+  tcgetattr(master, &options);
+  cfmakeraw(&options);
+  tcsetattr(master, TCSANOW, &options);
+
+  ControlClient client;
+
+  if (!client.open(ptsname(master), 115200))
+  {
+    fprintf(stderr, "Cannot open %s.\n", ptsname(master));
+    return 1;
+  }
+
+  PtyStream stream(master);
+  ControlPort port(&stream, CONTROL_MAXIMUM_FRAME);
+  port.setCommandHandler(handleCommand);
+
+  //
+  // The client writes from its own thread; the pseudo-terminal
+  // only buffers a few KB.
+  //
+  std::atomic<bool> done(false);
+  bool sent = true;
+  bool ponged = false;
+  CRGB* leds = new CRGB[numberOfLeds];
+
+  Benchmark timer;
+  timer.start();
+
+  std::thread writer([&]()
+  {
+    for (long f = 0; f < frames && sent; f++)
+    {
+      for (long i = 0; i < numberOfLeds; i++)
+      {
+        leds[i] = CRGB((uint8_t)i, (uint8_t)f, (uint8_t)(i + f));
+      }
+
+      sent = client.sendFrame(0, leds, (uint16_t)numberOfLeds, true);
+    }
+
+    ponged = client.ping(1000);
+    done = true;
+  });
+
+  while (!done)
+  {
+    if (port.poll(4096) == 0)
+    {
+      delayMicroseconds(50);
+    }
+  }
+
+  writer.join();
+
+  double elapsed = timer.elapsed();
+  bool passed = sent && ponged && port.errors == 0 && _mismatches == 0 && _shows == frames && _ledsReceived == frames * numberOfLeds;
+
+  printf("%ld frames x %ld LEDs, %llu bytes\n", frames, numberOfLeds, (unsigned long long)client.bytesWritten);
+  printf("%.1f frames/s, %.0f KB/s, %u commands, %u errors\n", frames / (elapsed / 1e9), client.bytesWritten / (elapsed / 1e9) / 1024.0, port.commands, port.errors);
+
+  delete[] leds;
+  client.close();
+  close(master);
+
+  return passed ? 0 : 1;
+}
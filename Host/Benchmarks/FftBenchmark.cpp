@@ -0,0 +1,198 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cmath>
+#include <vector>
+#include "Benchmark.h"
+#include "AudioAnalyzer.h"
+#include "WavSource.h"
+
+//
+// The sample rate of the ADC in the sample sketch.
+//
+#define FFT_BENCHMARK_SAMPLE_RATE   9615
+
+//
+// Writes a 16-bit stereo WAV file of a tone sweeping from 100 Hz
+// to just below half the sample rate.
+//
+static bool writeSweep(const char* path, uint32_t sampleRate, uint32_t numberOfSamples)
+{
+  FILE* file = fopen(path, "wb");
+
+  if (file == NULL)
+  {
+    return false;
+  }
+
+  uint32_t dataLength = numberOfSamples * 4;
+  uint8_t header[44] =
+  {
+    'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+    'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 16, 0,
+    'd', 'a', 't', 'a', 0, 0, 0, 0
+  };
+
+  uint32_t values[4][2] = { { 4, 36 + dataLength }, { 24, sampleRate }, { 28, sampleRate * 4 }, { 40, dataLength } };
+
+  for (auto& value : values)
+  {
+    for (uint8_t b = 0; b < 4; b++)
+    {
+      header[value[0] + b] = (uint8_t)(value[1] >> (8 * b));
+    }
+  }
+
+  fwrite(header, 1, sizeof(header), file);
+
+  double phase = 0.0;
+
+  for (uint32_t i = 0; i < numberOfSamples; i++)
+  {
+    double frequency = 100.0 + (sampleRate / 2.0 - 200.0) * i / numberOfSamples;
+    int16_t sample = (int16_t)(12000.0 * sin(phase));
+    uint8_t bytes[4] = { (uint8_t)sample, (uint8_t)(sample >> 8), (uint8_t)sample, (uint8_t)(sample >> 8) };
+
+    fwrite(bytes, 1, sizeof(bytes), file);
+    phase += 2.0 * M_PI * frequency / sampleRate;
+  }
+
+  fclose(file);
+
+  return true;
+}
+
+//
+// Reports, for transforms of 64, 128 and 256 samples:
+//
+//  - the throughput of the FFT alone (window, transform and
+//    magnitudes) in blocks per second and as a multiple of the
+//    sample rate (how much faster than real time it is), and
+//  - the latency of the analyzer fed from a WAV file: the time to
+//    collect a block of samples plus the mean and worst time to
+//    analyze it.
+//
+// A tone in the middle of a bin must give the largest magnitude
+// in that bin.
+//
+//  --blocks N      The number of blocks transformed for throughput (default 20000).
+//  --seconds N     The length of the sweep analyzed for latency (default 60).
+//
+int main(int argc, char** argv)
+{
+  bool quick = Benchmark::quick(argc, argv);
+  long blocks = Benchmark::option(argc, argv, "--blocks", quick ? 100 : 20000);
+  long seconds = Benchmark::option(argc, argv, "--seconds", quick ? 1 : 60);
+  const uint16_t sizes[] = { 64, 128, 256 };
+  const char* path = "FftBenchmark.wav";
+  bool passed = writeSweep(path, FFT_BENCHMARK_SAMPLE_RATE, (uint32_t)(seconds * FFT_BENCHMARK_SAMPLE_RATE));
+
+  printf("%u Hz, %ld s sweep\n", FFT_BENCHMARK_SAMPLE_RATE, seconds);
+  printf("size  blocks/s  x real time  collect ms  analyze us  worst us\n");
+
+  for (uint16_t size : sizes)
+  {
+    Fft fft(size);
+    std::vector<int16_t> real(size);
+    std::vector<int16_t> imaginary(size);
+    std::vector<uint16_t> magnitudes(size >> 1);
+
+    //
+    // Check a tone centered on bin size / 8.
+    //
+    uint16_t bin = size >> 3;
+
+    for (uint16_t i = 0; i < size; i++)
+    {
+      real[i] = (int16_t)(12000.0 * sin(2.0 * M_PI * bin * i / size));
+      imaginary[i] = 0;
+    }
+
+    fft.window(real.data());
+    fft.transform(real.data(), imaginary.data());
+    fft.magnitudes(real.data(), imaginary.data(), magnitudes.data());
+
+    uint16_t loudest = 0;
+
+    for (uint16_t i = 1; i < (size >> 1); i++)
+    {
+      loudest = magnitudes[i] > magnitudes[loudest] ? i : loudest;
+    }
+
+    passed = passed && loudest == bin;
+
+    //
+    // Throughput of the transform alone.
+    //
+    Benchmark timer;
+    timer.start();
+
+    for (long block = 0; block < blocks; block++)
+    {
+      for (uint16_t i = 0; i < size; i++)
+      {
+        real[i] = (int16_t)((i * 2654435761U + block) >> 20);
+        imaginary[i] = 0;
+      }
+
+      fft.window(real.data());
+      fft.transform(real.data(), imaginary.data());
+      fft.magnitudes(real.data(), imaginary.data(), magnitudes.data());
+      benchmarkKeep(magnitudes[1]);
+    }
+
+    double rate = blocks / (timer.elapsed() / 1e9);
+
+    //
+    // Latency of the analyzer reading the sweep a block at a time,
+    // the way loop() would.
+    //
+    AudioInput input(size << 1, FFT_BENCHMARK_SAMPLE_RATE);
+    AudioAnalyzer analyzer(&input, size, 16);
+    WavSource source;
+    double total = 0.0;
+    double worst = 0.0;
+    long analyzed = 0;
+
+    passed = passed && source.open(path);
+
+    while (source.feed(&input, size) > 0)
+    {
+      timer.start();
+      bool updated = analyzer.update();
+      double elapsed = timer.elapsed();
+
+      if (updated)
+      {
+        total += elapsed;
+        worst = std::max(worst, elapsed);
+        analyzed++;
+      }
+    }
+
+    passed = passed && input.dropped == 0 && analyzed == (seconds * FFT_BENCHMARK_SAMPLE_RATE) / size;
+
+    printf("%4u  %8.0f  %11.0f  %10.2f  %10.2f  %8.2f\n", (unsigned)size, rate, rate * size / FFT_BENCHMARK_SAMPLE_RATE, 1000.0 * size / FFT_BENCHMARK_SAMPLE_RATE, total / max(analyzed, 1L) / 1000.0, worst / 1000.0);
+  }
+
+  remove(path);
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cmath>
+#include <vector>
+#include "Benchmark.h"
+#include "FixedMath.h"
+
+//
+// The same gradient noise as FixedMath::Noise8(x, y) calculated
+// with doubles; the error of the fixed-point kernel is measured
+// against it.
+//
+static double noiseReference(double x, double y)
+{
+  int xi = (int)floor(x) & 0xFF;
+  int yi = (int)floor(y) & 0xFF;
+  double xf = x - floor(x);
+  double yf = y - floor(y);
+
+  auto permute = [](int i) { return (int)FIXED_MATH_PERMUTATION[i & 0xFF]; };
+  auto ease = [](double t) { return t * t * (3.0 - 2.0 * t); };
+  auto lerp = [](double a, double b, double t) { return a + (b - a) * t; };
+  auto gradient = [](int hash, double x, double y)
+  {
+    int h = hash & 0x07;
+
+    if (h < 4)
+    {
+      return ((h & 0x01) ? -x : x) + ((h & 0x02) ? -y : y);
+    }
+
+    double u = (h & 0x02) ? y : x;
+
+    return (h & 0x01) ? -u : u;
+  };
+
+  int a = (permute(xi) + yi) & 0xFF;
+  int b = (permute(xi + 1) + yi) & 0xFF;
+  double u = ease(xf);
+  double v = ease(yf);
+
+  double x1 = lerp(gradient(permute(a), xf, yf), gradient(permute(b), xf - 1.0, yf), u);
+  double x2 = lerp(gradient(permute(a + 1), xf, yf - 1.0), gradient(permute(b + 1), xf - 1.0, yf - 1.0), u);
+
+  //
+  // Scaled the same way as the fixed-point result.
+  //
+  double n = 128.0 + lerp(x1, x2, v) * 256.0 * 0.75;
+
+  return n < 0.0 ? 0.0 : (n > 255.0 ? 255.0 : n);
+}
+
+//
+// Times a function called for every 16-bit argument and returns
+// the ns per call.
+//
+template <typename F>
+static double timeCalls(long passes, F function)
+{
+  Benchmark timer;
+  timer.start();
+
+  for (long pass = 0; pass < passes; pass++)
+  {
+    for (uint32_t i = 0; i < 65536; i++)
+    {
+      benchmarkKeep(function((uint16_t)i, pass));
+    }
+  }
+
+  return timer.elapsed() / (passes * 65536.0);
+}
+
+//
+// Compares the fixed-point math with a double reference: the ns
+// per call of each and the largest error of the fixed-point result.
+// The last row is a plasma frame (two sine waves and the 2D noise
+// for every LED) calculated both ways.
+//
+//  --passes N      The number of passes over the 16-bit arguments (default 50).
+//  --leds N        The number of LEDs in the plasma frame (default 300).
+//
+int main(int argc, char** argv)
+{
+  bool quick = Benchmark::quick(argc, argv);
+  long passes = Benchmark::option(argc, argv, "--passes", quick ? 1 : 50);
+  long numberOfLeds = Benchmark::option(argc, argv, "--leds", 300);
+  bool passed = true;
+
+  printf("function   fixed ns  double ns  max error\n");
+
+  //
+  // Sin16 against sin(), error in counts of 32767.
+  //
+  {
+    double fixed = timeCalls(passes, [](uint16_t i, long) { return FixedMath::Sin16(i); });
+    double reference = timeCalls(passes, [](uint16_t i, long) { return sin(i * (2.0 * M_PI / 65536.0)); });
+    double error = 0.0;
+
+    for (uint32_t i = 0; i < 65536; i++)
+    {
+      error = std::max(error, fabs(FixedMath::Sin16((uint16_t)i) - 32767.0 * sin(i * (2.0 * M_PI / 65536.0))));
+    }
+
+    printf("Sin16      %8.2f  %9.2f  %9.2f\n", fixed, reference, error);
+    passed = passed && error <= 4.0;
+  }
+
+  //
+  // Sqrt32 against sqrt(); the fixed-point result is the floor.
+  //
+  {
+    double fixed = timeCalls(passes, [](uint16_t i, long pass) { return FixedMath::Sqrt32(((uint32_t)i << 16) | (uint32_t)pass); });
+    double reference = timeCalls(passes, [](uint16_t i, long pass) { return sqrt((double)(((uint32_t)i << 16) | (uint32_t)pass)); });
+    double error = 0.0;
+
+    for (uint32_t i = 0; i < 65536; i++)
+    {
+      uint32_t value = i * 65537;
+      error = std::max(error, fabs(FixedMath::Sqrt32(value) - floor(sqrt((double)value))));
+    }
+
+    printf("Sqrt32     %8.2f  %9.2f  %9.2f\n", fixed, reference, error);
+    passed = passed && error == 0.0;
+  }
+
+  //
+  // Noise8(x, y) against the double reference.
+  //
+  {
+    double fixed = timeCalls(passes, [](uint16_t i, long pass) { return FixedMath::Noise8(i, (uint16_t)(pass * 37)); });
+    double reference = timeCalls(passes, [](uint16_t i, long pass) { return noiseReference(i / 256.0, pass * 37 / 256.0); });
+    double error = 0.0;
+
+    for (uint32_t i = 0; i < 65536; i++)
+    {
+      uint16_t x = (uint16_t)(i * 97);
+      uint16_t y = (uint16_t)(i * 13);
+      error = std::max(error, fabs(FixedMath::Noise8(x, y) - noiseReference(x / 256.0, y / 256.0)));
+    }
+
+    printf("Noise8 2D  %8.2f  %9.2f  %9.2f\n", fixed, reference, error);
+    passed = passed && error <= 4.0;
+  }
+
+  //
+  // The 1D and 3D kernels have no reference; only their speed.
+  //
+  printf("Noise8 1D  %8.2f\n", timeCalls(passes, [](uint16_t i, long) { return FixedMath::Noise8(i); }));
+  printf("Noise8 3D  %8.2f\n", timeCalls(passes, [](uint16_t i, long pass) { return FixedMath::Noise8(i, (uint16_t)(pass * 37), (uint16_t)(pass * 11)); }));
+
+  //
+  // A plasma frame: the hue for every LED from two sine waves
+  // and the noise, as in PlasmaEffect.
+  //
+  {
+    std::vector<uint8_t> hues((size_t)numberOfLeds);
+    long frames = passes * 1000;
+
+    Benchmark timer;
+    timer.start();
+
+    for (long frame = 0; frame < frames; frame++)
+    {
+      uint8_t t = (uint8_t)frame;
+      uint16_t position = 0;
+
+      for (long i = 0; i < numberOfLeds; i++)
+      {
+        hues[i] = (uint8_t)(FixedMath::Sin8((uint8_t)(position >> 8) + t) +
+                            FixedMath::Sin8((uint8_t)(position >> 7) - (uint8_t)(t << 1)) +
+                            FixedMath::Noise8(position, (uint16_t)(frame << 3)));
+        position += 16 << 4;
+      }
+
+      benchmarkKeep(hues[0]);
+    }
+
+    double fixed = timer.elapsed() / frames;
+
+    timer.start();
+
+    for (long frame = 0; frame < frames; frame++)
+    {
+      double t = (frame & 0xFF) / 256.0;
+      double position = 0.0;
+
+      for (long i = 0; i < numberOfLeds; i++)
+      {
+        double hue = 127.0 * sin(2.0 * M_PI * (position + t)) +
+                     127.0 * sin(2.0 * M_PI * (2.0 * position - 2.0 * t)) +
+                     noiseReference(position * 256.0, frame / 32.0);
+        hues[i] = (uint8_t)(int)hue;
+        position += 1.0 / 256.0;
+      }
+
+      benchmarkKeep(hues[0]);
+    }
+
+    double reference = timer.elapsed() / frames;
+
+    printf("Plasma     %8.0f  %9.0f  ns/frame, %ld LEDs\n", fixed, reference, numberOfLeds);
+  }
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.h"
+#include "ParticleEffect.h"
+#include "RenderEngine.h"
+
+//
+// Keeps the pool full so every frame moves, ages and draws
+// the same number of particles.
+//
+class FullParticleEffect : public ParticleEffect
+{
+  public:
+    FullParticleEffect(CRGB *leds, uint32_t numberOfLeds, uint16_t capacity) : ParticleEffect(leds, numberOfLeds, 16, capacity, 0, 1, 192)
+    {
+    }
+
+    //
+    // Renders one frame without waiting for the clock.
+    //
+    void frame()
+    {
+      this->onAnimate();
+    }
+
+    uint16_t count()
+    {
+      return this->_count;
+    }
+
+  protected:
+    void onEmit()
+    {
+      while (this->emit((int32_t)random16((uint16_t)this->_numberOfLeds) << 8, (int16_t)random8() - 128, 255, random8()))
+      {
+      }
+    }
+};
+
+//
+// Renders a strip with 16, 256 and 4096 particles and reports
+// the time per frame and per particle.
+//
+//  --leds N        The number of LEDs (default 300).
+//  --frames N      The number of frames rendered for each pool (default 2000).
+//
+int main(int argc, char** argv)
+{
+  bool quick = Benchmark::quick(argc, argv);
+  long numberOfLeds = Benchmark::option(argc, argv, "--leds", 300);
+  long frames = Benchmark::option(argc, argv, "--frames", quick ? 20 : 2000);
+  const uint16_t capacities[] = { 16, 256, 4096 };
+  bool passed = true;
+
+  CRGB* leds = RenderEngine::createLeds((uint32_t)numberOfLeds);
+
+  printf("%ld LEDs, %ld frames\n", numberOfLeds, frames);
+  printf("particles  ns/frame  ns/particle\n");
+
+  for (uint16_t capacity : capacities)
+  {
+    FullParticleEffect effect(leds, (uint32_t)numberOfLeds, capacity);
+    effect.reset();
+    effect.frame();
+
+    Benchmark timer;
+    timer.start();
+
+    for (long frame = 0; frame < frames; frame++)
+    {
+      effect.frame();
+    }
+
+    double elapsed = timer.elapsed();
+
+    printf("%9u  %8.0f  %11.2f\n", (unsigned)capacity, elapsed / frames, elapsed / frames / capacity);
+
+    //
+    // The pool is refilled on every frame.
+    //
+    passed = passed && effect.count() == capacity;
+  }
+
+  RenderEngine::destroyLeds(leds);
+
+  return passed ? 0 : 1;
+}
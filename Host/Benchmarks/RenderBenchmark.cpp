@@ -0,0 +1,136 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "RenderEngine.h"
+#include "PlasmaEffect.h"
+#include "Clock.h"
+
+//
+// Counts the frames shown.
+//
+class CountingOutput : public IOutput
+{
+  public:
+    CountingOutput(CRGB *leds, uint32_t numberOfLeds) : IOutput(leds, numberOfLeds)
+    {
+    }
+
+    bool show()
+    {
+      this->frames++;
+      return true;
+    }
+
+    uint32_t frames = 0;
+};
+
+//
+// Renders many strips with 1 to N threads and reports the frame
+// rate and the speedup over a single thread.
+//
+//  --threads N     The largest number of threads (default: cores).
+//  --strips N      The number of strips (default 256).
+//  --leds N        The number of LEDs per strip (default 300).
+//  --frames N      The number of frames rendered per run (default 200).
+//
+int main(int argc, char** argv)
+{
+  bool quick = Benchmark::quick(argc, argv);
+  long cores = (long)std::thread::hardware_concurrency();
+  long maximumThreads = Benchmark::option(argc, argv, "--threads", quick ? 2 : (cores > 0 ? cores : 1));
+  long numberOfStrips = Benchmark::option(argc, argv, "--strips", quick ? 16 : 256);
+  long numberOfLeds = Benchmark::option(argc, argv, "--leds", quick ? 60 : 300);
+  long frames = Benchmark::option(argc, argv, "--frames", quick ? 10 : 200);
+
+  //
+  // Every strip is due on every frame: the clock moves one
+  // frame length before each render.
+  //
+  ManualClock clock;
+  Clock::use(&clock);
+
+  std::vector<CRGB*> leds;
+  std::vector<IEffect*> effects;
+  std::vector<CountingOutput*> outputs;
+
+  for (long i = 0; i < numberOfStrips; i++)
+  {
+    leds.push_back(RenderEngine::createLeds((uint32_t)numberOfLeds));
+    effects.push_back(new PlasmaEffect(leds.back(), (uint32_t)numberOfLeds, 16, (uint8_t)(8 + (i % 16))));
+    outputs.push_back(new CountingOutput(leds.back(), (uint32_t)numberOfLeds));
+  }
+
+  printf("%ld strips x %ld LEDs, %ld frames, %ld cores\n", numberOfStrips, numberOfLeds, frames, cores);
+  printf("threads  frames/s  ns/strip  speedup  efficiency\n");
+
+  double single = 0.0;
+  bool passed = true;
+
+  for (long threads = 1; threads <= maximumThreads; threads++)
+  {
+    RenderEngine engine((uint16_t)numberOfStrips, (uint16_t)threads);
+
+    for (long i = 0; i < numberOfStrips; i++)
+    {
+      engine.add(effects[i], outputs[i]);
+    }
+
+    engine.reset();
+
+    Benchmark timer;
+    timer.start();
+    long rendered = 0;
+
+    for (long frame = 0; frame < frames; frame++)
+    {
+      clock.advance(16);
+      rendered += engine.render();
+    }
+
+    double elapsed = timer.elapsed();
+    double rate = frames / (elapsed / 1e9);
+
+    if (threads == 1)
+    {
+      single = rate;
+    }
+
+    printf("%7ld  %8.1f  %8.0f  %7.2f  %9.0f%%\n", threads, rate, elapsed / (frames * numberOfStrips), rate / single, 100.0 * rate / single / threads);
+
+    //
+    // Every strip is due on every frame.
+    //
+    passed = passed && rendered == frames * numberOfStrips;
+  }
+
+  for (long i = 0; i < numberOfStrips; i++)
+  {
+    delete outputs[i];
+    delete effects[i];
+    RenderEngine::destroyLeds(leds[i]);
+  }
+
+  Clock::use(NULL);
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cmath>
+#include "Check.h"
+#include "AudioAnalyzer.h"
+#include "Fft.h"
+#include "SpectrumEffect.h"
+#include "Clock.h"
+
+#define AUDIO_TEST_SIZE     64
+
+//
+// Exposes the automatic gain peak.
+//
+class TestAnalyzer : public AudioAnalyzer
+{
+  public:
+    TestAnalyzer(AudioInput* input, uint16_t size, uint8_t numberOfBands) : AudioAnalyzer(input, size, numberOfBands)
+    {
+    }
+
+    uint16_t peak()
+    {
+      return this->_peak;
+    }
+};
+
+//
+// Pushes a block of a tone (or silence when amplitude is 0).
+//
+static void pushBlock(AudioInput& input, double amplitude)
+{
+  for (uint16_t i = 0; i < AUDIO_TEST_SIZE; i++)
+  {
+    input.push((int16_t)(amplitude * sin(2.0 * M_PI * 8 * i / AUDIO_TEST_SIZE)));
+  }
+}
+
+//
+// No bands is treated as one band rather than dividing by 0.
+//
+static void testNoBands()
+{
+  static CRGB leds[30];
+
+  ManualClock clock;
+  Clock::use(&clock);
+
+  AudioInput input(AUDIO_TEST_SIZE * 2, 9615);
+  AudioAnalyzer analyzer(&input, AUDIO_TEST_SIZE, 0);
+  SpectrumEffect effect(leds, 30, 16, &analyzer);
+
+  CHECK(analyzer.numberOfBands == 1);
+
+  pushBlock(input, 8000.0);
+  clock.advance(16);
+  CHECK(effect.animate());
+  CHECK(analyzer.bands[0] == 255);
+
+  Clock::use(NULL);
+}
+
+//
+// The peak follows a loud block and decays all the way to 0
+// in silence.
+//
+static void testPeakDecay()
+{
+  AudioInput input(AUDIO_TEST_SIZE * 2, 9615);
+  TestAnalyzer analyzer(&input, AUDIO_TEST_SIZE, 4);
+
+  pushBlock(input, 8000.0);
+  CHECK(analyzer.update());
+  CHECK(analyzer.peak() > 0);
+
+  for (uint16_t block = 0; block < 1000; block++)
+  {
+    pushBlock(input, 0.0);
+    analyzer.update();
+  }
+
+  CHECK(analyzer.peak() == 0);
+}
+
+//
+// A cosine (or sine) of amplitude A that completes k cycles in the
+// block lands in bin k with magnitude A / 2 (the output is divided
+// by the size) and a real (or negative imaginary) part; every other
+// bin stays near 0.
+//
+static void testSinusoid()
+{
+  static const uint16_t sizes[] = { 64, 256 };
+  static int16_t real[256];
+  static int16_t imaginary[256];
+  static uint16_t magnitudes[128];
+
+  for (uint16_t size : sizes)
+  {
+    Fft fft(size);
+
+    for (uint16_t k = 1; k < size / 2; k += 7)
+    {
+      for (uint8_t phase = 0; phase < 2; phase++)
+      {
+        for (uint16_t i = 0; i < size; i++)
+        {
+          double angle = 2.0 * M_PI * k * i / size;
+          real[i] = (int16_t)lround(16000.0 * (phase == 0 ? cos(angle) : sin(angle)));
+          imaginary[i] = 0;
+        }
+
+        fft.transform(real, imaginary);
+
+        if (phase == 0)
+        {
+          CHECK(abs(real[k] - 8000) <= 8 && abs(imaginary[k]) <= 8);
+        }
+        else
+        {
+          CHECK(abs(real[k]) <= 8 && abs(imaginary[k] + 8000) <= 8);
+        }
+
+        fft.magnitudes(real, imaginary, magnitudes);
+
+        for (uint16_t bin = 0; bin < size / 2; bin++)
+        {
+          CHECK(bin == k ? abs(magnitudes[bin] - 8000) <= 8 : magnitudes[bin] <= 8);
+        }
+      }
+    }
+  }
+}
+
+//
+// The Hann window spreads a tone over its bin (A / 4) and the
+// two bins beside it (A / 8 each).
+//
+static void testWindow()
+{
+  static int16_t real[64];
+  static int16_t imaginary[64];
+  static uint16_t magnitudes[32];
+
+  Fft fft(64);
+
+  for (uint16_t i = 0; i < 64; i++)
+  {
+    real[i] = (int16_t)lround(16000.0 * cos(2.0 * M_PI * 10 * i / 64));
+    imaginary[i] = 0;
+  }
+
+  fft.window(real);
+  fft.transform(real, imaginary);
+  fft.magnitudes(real, imaginary, magnitudes);
+
+  CHECK(abs(magnitudes[10] - 4000) <= 8);
+  CHECK(abs(magnitudes[9] - 2000) <= 8);
+  CHECK(abs(magnitudes[11] - 2000) <= 8);
+  CHECK(magnitudes[8] <= 8 && magnitudes[12] <= 8);
+}
+
+//
+// When blocks arrive faster than update() is called only the
+// newest is analyzed and the input never backs up.
+//
+static void testBacklog()
+{
+  AudioInput input(AUDIO_TEST_SIZE * 8, 44100);
+  AudioAnalyzer analyzer(&input, AUDIO_TEST_SIZE, 4);
+
+  for (uint16_t frame = 0; frame < 100; frame++)
+  {
+    //
+    // Three and a half blocks per frame: 44.1 kHz at 200 fps
+    // with 64 sample blocks.
+    //
+    for (uint16_t i = 0; i < (AUDIO_TEST_SIZE * 7) / 2; i++)
+    {
+      input.push((int16_t)(8000.0 * sin(2.0 * M_PI * 8 * i / AUDIO_TEST_SIZE)));
+    }
+
+    CHECK(analyzer.update());
+    CHECK(input.available() < AUDIO_TEST_SIZE);
+  }
+
+  CHECK(input.dropped == 0);
+}
+
+//
+// A full-scale sample far from the mean is saturated rather
+// than wrapped: a single high sample in a block at the lowest
+// level is an impulse, whose energy is spread over every band.
+//
+static void testFullScale()
+{
+  AudioInput input(AUDIO_TEST_SIZE * 2, 9615);
+  AudioAnalyzer analyzer(&input, AUDIO_TEST_SIZE, 4);
+
+  for (uint16_t i = 0; i < AUDIO_TEST_SIZE; i++)
+  {
+    input.push(i == AUDIO_TEST_SIZE / 2 ? 32767 : -32768);
+  }
+
+  CHECK(analyzer.update());
+  CHECK(analyzer.energy > 10000);
+
+  for (uint8_t b = 0; b < analyzer.numberOfBands; b++)
+  {
+    CHECK(analyzer.bands[b] > 100);
+  }
+}
+
+int main()
+{
+  testNoBands();
+  testPeakDecay();
+  testSinusoid();
+  testWindow();
+  testBacklog();
+  testFullScale();
+
+  return CHECK_RESULT();
+}
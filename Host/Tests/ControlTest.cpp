@@ -0,0 +1,207 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+#include "Check.h"
+#include "ControlClient.h"
+#include "ControlPort.h"
+
+//
+// A Stream that keeps what is written; the test decides what
+// reaches the client.
+//
+class MemoryStream : public Stream
+{
+  public:
+    int available()
+    {
+      return 0;
+    }
+
+    int read()
+    {
+      return -1;
+    }
+
+    int peek()
+    {
+      return -1;
+    }
+
+    size_t write(uint8_t value)
+    {
+      this->data.push_back(value);
+      return 1;
+    }
+
+    std::vector<uint8_t> data;
+};
+
+//
+// The sketch side of a pseudo-terminal with a client opened on
+// the other side.
+//
+static int _master = -1;
+
+static bool openPty(ControlClient &client)
+{
+  _master = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if (_master < 0 || grantpt(_master) != 0 || unlockpt(_master) != 0)
+  {
+    return false;
+  }
+
+  struct termios options;
+  tcgetattr(_master, &options);
+  cfmakeraw(&options);
+  tcsetattr(_master, TCSANOW, &options);
+
+  return client.open(ptsname(_master), 115200);
+}
+
+static void closePty(ControlClient &client)
+{
+  client.close();
+  ::close(_master);
+  _master = -1;
+}
+
+//
+// Writes bytes as the sketch would.
+//
+static void sketchWrite(const uint8_t *data, size_t length)
+{
+  CHECK(::write(_master, data, length) == (ssize_t)length);
+}
+
+static void sketchPrint(const char *text)
+{
+  sketchWrite((const uint8_t*)text, strlen(text));
+}
+
+//
+// Debug text printed before a reply does not cost the reply.
+//
+static void testTextBeforeFrame()
+{
+  ControlClient client;
+  CHECK(openPty(client));
+
+  MemoryStream stream;
+  ControlPort port(&stream, CONTROL_MAXIMUM_FRAME);
+  CHECK(port.send(CONTROL_PONG, NULL, 0));
+
+  sketchPrint("Offset Base = 6");
+  sketchWrite(stream.data.data(), stream.data.size());
+
+  uint8_t frame[CONTROL_MAXIMUM_ENCODED];
+  CHECK(client.receive(frame, 500) == 1);
+  CHECK(frame[0] == CONTROL_PONG);
+
+  closePty(client);
+}
+
+//
+// Writes a dump through a ControlWriter and returns the encoded
+// replies, one per entry.
+//
+static std::vector<std::vector<uint8_t>> writeDump(const std::vector<uint8_t> &dump)
+{
+  MemoryStream stream;
+  ControlPort port(&stream, CONTROL_MAXIMUM_FRAME);
+  ControlWriter writer(&port, CONTROL_TRACE);
+
+  writer.write(dump.data(), dump.size());
+  writer.end();
+
+  std::vector<std::vector<uint8_t>> returnValue;
+  std::vector<uint8_t> reply;
+
+  for (uint8_t b : stream.data)
+  {
+    reply.push_back(b);
+
+    if (b == 0 && reply.size() > 1)
+    {
+      returnValue.push_back(reply);
+      reply.clear();
+    }
+  }
+
+  return returnValue;
+}
+
+//
+// trace() reassembles a dump sent among debug text, and reports a
+// lost reply rather than returning the dump without it.
+//
+static void testTrace()
+{
+  std::vector<uint8_t> dump;
+
+  for (uint16_t i = 0; i < 100; i++)
+  {
+    dump.push_back((uint8_t)(i * 7));
+  }
+
+  std::vector<std::vector<uint8_t>> replies = writeDump(dump);
+  CHECK(replies.size() == 8);
+
+  ControlClient client;
+  CHECK(openPty(client));
+
+  uint8_t buffer[256];
+
+  for (size_t i = 0; i < replies.size(); i++)
+  {
+    sketchPrint("WARNING: frame rate too high!\r\n");
+    sketchWrite(replies[i].data(), replies[i].size());
+  }
+
+  CHECK(client.trace(buffer, sizeof(buffer), 500) == (int32_t)dump.size());
+  CHECK(memcmp(buffer, dump.data(), dump.size()) == 0);
+
+  //
+  // Lose the third reply.
+  //
+  for (size_t i = 0; i < replies.size(); i++)
+  {
+    if (i != 2)
+    {
+      sketchWrite(replies[i].data(), replies[i].size());
+    }
+  }
+
+  CHECK(client.trace(buffer, sizeof(buffer), 500) == -1);
+
+  closePty(client);
+}
+
+int main()
+{
+  testTextBeforeFrame();
+  testTrace();
+
+  return CHECK_RESULT();
+}
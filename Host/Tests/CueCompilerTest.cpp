@@ -0,0 +1,138 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <string>
+#include "Check.h"
+#include "CueCompiler.h"
+
+//
+// Compiles a cue list and returns the header it wrote.
+//
+static bool compile(CueCompiler &compiler, const char *text, std::string &header)
+{
+  FILE* input = tmpfile();
+  FILE* output = tmpfile();
+  char buffer[256];
+  size_t length;
+
+  fputs(text, input);
+  rewind(input);
+
+  bool returnValue = compiler.compile(input, output, "SHOW");
+
+  header.clear();
+  rewind(output);
+
+  while ((length = fread(buffer, 1, sizeof(buffer), output)) > 0)
+  {
+    header.append(buffer, length);
+  }
+
+  fclose(input);
+  fclose(output);
+
+  return returnValue;
+}
+
+//
+// Compiles the cue list in README.md: comments and blank lines are
+// skipped, each cue starts where the previous one ended and the
+// parameters are written in the order they were given.
+//
+static void testShow()
+{
+  CueCompiler compiler;
+  std::string header;
+
+  CHECK(compile(compiler,
+                "# effect duration [cut | fade length] [parameter=value ...]\n"
+                "0 10000 fade 500 color=0xF50C0C\n"
+                "\n"
+                "3 5000 length=6 fade=0.5\r\n"
+                "1 20000 cut frameLength=25\n", header));
+
+  CHECK(compiler.error == NULL);
+  CHECK(compiler.numberOfCues == 3);
+  CHECK(compiler.length == 35000);
+
+  CHECK(header.find("CUE_HEADER(3)") != std::string::npos);
+  CHECK(header.find("CUE(0, 10000, 0, CUE_FADE, 500, 1, 0xF50C0C, 255, 0x0)") != std::string::npos);
+  CHECK(header.find("CUE(10000, 5000, 3, CUE_CUT, 0, 2, 0x6, 3, 0x1F4)") != std::string::npos);
+  CHECK(header.find("CUE(15000, 20000, 1, CUE_CUT, 0, 0, 0x19, 255, 0x0)") != std::string::npos);
+}
+
+//
+// An empty cue list is a show with no cues.
+//
+static void testEmpty()
+{
+  CueCompiler compiler;
+  std::string header;
+
+  CHECK(compile(compiler, "# nothing yet\n", header));
+  CHECK(compiler.numberOfCues == 0);
+  CHECK(header.find("CUE_HEADER(0)\n};") != std::string::npos);
+}
+
+//
+// Each kind of bad token is reported with the line it is on.
+//
+static void testErrors()
+{
+  static const struct
+  {
+    const char* text;
+    const char* error;
+  } ERRORS[] =
+  {
+    { "0 1000\nx 1000\n", "expected an effect and a duration" },
+    { "0 1000\n1\n", "expected an effect and a duration" },
+    { "0 1000\n1 0\n", "the duration must be a number greater than 0" },
+    { "0 1000\n1 10s\n", "the duration must be a number greater than 0" },
+    { "0 1000\n1 1000 fade\n", "expected the length of the fade" },
+    { "0 1000\n1 1000 fade 5x\n", "invalid number" },
+    { "0 1000\n1 1000 color=0xGG\n", "invalid number" },
+    { "0 1000\n1 1000 fade=half\n", "invalid number" },
+    { "0 1000\n1 1000 speed=2\n", "unknown parameter" },
+    { "0 1000\n1 1000 color=0xFF length=2 fade=0.5\n", "a cue can have at most two parameters" },
+    { "0 1000\n1 1000 dissolve\n", "unexpected text" }
+  };
+
+  for (size_t i = 0; i < sizeof(ERRORS) / sizeof(ERRORS[0]); i++)
+  {
+    CueCompiler compiler;
+    std::string header;
+
+    CHECK(!compile(compiler, ERRORS[i].text, header));
+    CHECK(compiler.error != NULL && strcmp(compiler.error, ERRORS[i].error) == 0);
+    CHECK(compiler.line == 2);
+    CHECK(header.empty());
+  }
+}
+
+int main()
+{
+  testShow();
+  testEmpty();
+  testErrors();
+
+  return CHECK_RESULT();
+}
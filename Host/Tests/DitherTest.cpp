@@ -0,0 +1,103 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "DitherOutput.h"
+#include "TailEffect.h"
+
+#define DITHER_TEST_LEDS    10
+
+//
+// Counts the frames shown and how many had the first LED lit.
+//
+class CountingOutput : public IOutput
+{
+  public:
+    CountingOutput(CRGB *leds, uint32_t numberOfLeds) : IOutput(leds, numberOfLeds)
+    {
+    }
+
+    bool show()
+    {
+      this->frames++;
+      this->lit += this->_leds[0].r != 0 ? 1 : 0;
+      return true;
+    }
+
+    uint32_t frames = 0;
+    uint32_t lit = 0;
+};
+
+//
+// refresh() advances the dither between frames on its own timer:
+// a quarter of the lowest step is lit on one refresh in four.
+//
+static void testRefresh()
+{
+  static CRGB leds[DITHER_TEST_LEDS];
+
+  HdrBuffer buffer(DITHER_TEST_LEDS);
+  CountingOutput* counting = new CountingOutput(leds, DITHER_TEST_LEDS);
+  DitherOutput output(leds, DITHER_TEST_LEDS, &buffer, counting);
+
+  buffer.setLed(0, CRGB16(0x0040, 0, 0));
+  CHECK(output.show());
+
+  //
+  // Not due yet.
+  //
+  CHECK(!output.refresh());
+
+  for (uint8_t i = 0; i < 63; i++)
+  {
+    advanceTime(DITHER_REFRESH_INTERVAL);
+    CHECK(output.refresh());
+  }
+
+  CHECK(counting->frames == 64);
+  CHECK(counting->lit == 16);
+
+  delete counting;
+}
+
+//
+// Resetting a tail drawn into the buffer clears the buffer.
+//
+static void testTailReset()
+{
+  static CRGB leds[DITHER_TEST_LEDS];
+
+  HdrBuffer buffer(DITHER_TEST_LEDS);
+  TailEffect effect(leds, DITHER_TEST_LEDS, 0, CRGB::White, 3, 0.5);
+  effect.useBuffer(&buffer);
+
+  buffer.setLed(5, CRGB16(0xFFFF, 0xFFFF, 0xFFFF));
+  effect.reset();
+
+  CHECK(buffer.pixels()[5].r == 0 && buffer.pixels()[5].g == 0 && buffer.pixels()[5].b == 0);
+}
+
+int main()
+{
+  testRefresh();
+  testTailReset();
+
+  return CHECK_RESULT();
+}
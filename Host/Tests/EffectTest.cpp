@@ -0,0 +1,104 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "Clock.h"
+#include "PlasmaEffect.h"
+
+#define EFFECT_TEST_LEDS    60
+#define EFFECT_TEST_FRAMES  300
+
+//
+// An EffectSet of StaticPlasmaEffects draws the same frames, at
+// the same times, as the PlasmaEffects they were ported from.
+//
+int main()
+{
+  static CRGB virtualLeds[2][EFFECT_TEST_LEDS];
+  static CRGB staticLeds[2][EFFECT_TEST_LEDS];
+
+  ManualClock clock;
+  clock.time = 1000;
+  Clock::use(&clock);
+
+  IEffect* effects[2] =
+  {
+    new PlasmaEffect(virtualLeds[0], EFFECT_TEST_LEDS, 16, 8),
+    new PlasmaEffect(virtualLeds[1], EFFECT_TEST_LEDS, 35, 24)
+  };
+
+  EffectSet<StaticPlasmaEffect, StaticPlasmaEffect> set(StaticPlasmaEffect(staticLeds[0], EFFECT_TEST_LEDS, 16, 8),
+                                                        StaticPlasmaEffect(staticLeds[1], EFFECT_TEST_LEDS, 35, 24));
+
+  CHECK((EffectSet<StaticPlasmaEffect, StaticPlasmaEffect>::count) == 2);
+
+  uint32_t drawn = 0;
+
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    CHECK(effects[i]->reset() == set.reset(i));
+  }
+
+  for (uint32_t frame = 0; frame < EFFECT_TEST_FRAMES; frame++)
+  {
+    //
+    // Switch effects part way through, as the buttons do.
+    //
+    uint8_t current = (frame / 100) % 2;
+
+    clock.advance(7);
+
+    bool virtualDrawn = effects[current]->animate();
+    bool staticDrawn = set.animate(current);
+
+    CHECK(virtualDrawn == staticDrawn);
+    drawn += staticDrawn ? 1 : 0;
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+      CHECK(memcmp(virtualLeds[i], staticLeds[i], sizeof(virtualLeds[i])) == 0);
+    }
+  }
+
+  //
+  // Both frame lengths are longer than the 7 ms step, so
+  // some passes draw and some do not.
+  //
+  CHECK(drawn > 0 && drawn < EFFECT_TEST_FRAMES);
+
+  //
+  // After a reset both start again from the first frame.
+  //
+  CHECK(effects[1]->reset() == set.reset(1));
+  CHECK(effects[1]->animate());
+  CHECK(set.animate(1));
+  CHECK(memcmp(virtualLeds[1], staticLeds[1], sizeof(virtualLeds[1])) == 0);
+
+  //
+  // An index past the end of the set does nothing.
+  //
+  CHECK(!set.animate(2));
+
+  delete effects[0];
+  delete effects[1];
+  Clock::use(NULL);
+
+  return CHECK_RESULT();
+}
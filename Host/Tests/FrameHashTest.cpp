@@ -0,0 +1,63 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include "Check.h"
+#include "FrameHash.h"
+
+//
+// Returns the hash of a string.
+//
+static uint32_t hashString(const char* text, uint32_t seed = 0)
+{
+  return FrameHash::hash((const uint8_t*)text, (uint32_t)strlen(text), seed);
+}
+
+//
+// The reference xxHash32 vectors: short input (only the tail
+// loops), input of 16 bytes or more (the four lanes) and a seed.
+//
+static void testVectors()
+{
+  CHECK(hashString("") == 0x02CC5D05);
+  CHECK(hashString("a") == 0x550D7456);
+  CHECK(hashString("abc") == 0x32D153FF);
+  CHECK(hashString("Nobody inspects the spammish repetition") == 0xE2293B2F);
+  CHECK(hashString("", 1) == 0x0B2CB792);
+}
+
+//
+// An LED array hashes the same as its bytes.
+//
+static void testLeds()
+{
+  CRGB leds[3] = { CRGB(1, 2, 3), CRGB(4, 5, 6), CRGB(7, 8, 9) };
+  const uint8_t bytes[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+  CHECK(FrameHash::hash(leds, 3) == FrameHash::hash(bytes, 9));
+}
+
+int main()
+{
+  testVectors();
+  testLeds();
+
+  return CHECK_RESULT();
+}
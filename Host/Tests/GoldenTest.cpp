@@ -0,0 +1,94 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <string>
+#include "Check.h"
+#include "GoldenHarness.h"
+#include "SingleColorEffect.h"
+#include "SpinningRainbow.h"
+#include "ColorWheelStripeEffect.h"
+#include "TailEffect.h"
+
+#define GOLDEN_TEST_LEDS    60
+#define GOLDEN_TEST_FRAMES  100
+
+//
+// Runs the four sample effects, set up as in led.ino, and compares
+// their frames with the golden files in Host/Golden. After a change
+// that is meant to alter what an effect draws, run with --record
+// to write new golden files and check them in.
+//
+//  --record        Writes the golden files instead of comparing.
+//  --tolerance N   Accepts frames with no channel off by more than N (default 0).
+//
+int main(int argc, char** argv)
+{
+  bool record = false;
+  long tolerance = 0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    record = record || strcmp(argv[i], "--record") == 0;
+
+    if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+    {
+      tolerance = strtol(argv[i + 1], NULL, 10);
+    }
+  }
+
+  static CRGB leds[GOLDEN_TEST_LEDS];
+
+  struct
+  {
+    const char* name;
+    IEffect* effect;
+  } effects[] =
+  {
+    { "SingleColorEffect", new SingleColorEffect(leds, GOLDEN_TEST_LEDS, 75, CRGB(245, 12, 12)) },
+    { "SpinningRainbow", new SpinningRainbow(leds, GOLDEN_TEST_LEDS, 350) },
+    { "ColorWheelStripeEffect", new ColorWheelStripeEffect(leds, GOLDEN_TEST_LEDS, 10, 4) },
+    { "TailEffect", new TailEffect(leds, GOLDEN_TEST_LEDS, 100, CRGB(0, 24, 210), 4, .65) }
+  };
+
+  GoldenHarness harness(leds, GOLDEN_TEST_LEDS);
+
+  for (auto& entry : effects)
+  {
+    std::string path = std::string(GOLDEN_DIRECTORY) + "/" + entry.name + ".golden";
+
+    harness.run(entry.effect, GOLDEN_TEST_FRAMES);
+
+    if (record)
+    {
+      CHECK(harness.write(path.c_str()));
+      printf("Recorded %s\n", path.c_str());
+    }
+    else
+    {
+      GoldenResult result = harness.compare(path.c_str(), (uint8_t)tolerance);
+      GoldenHarness::report(stdout, entry.name, result);
+      CHECK(result.passed);
+    }
+
+    delete entry.effect;
+  }
+
+  return CHECK_RESULT();
+}
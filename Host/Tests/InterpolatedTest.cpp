@@ -0,0 +1,151 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "Clock.h"
+#include "InterpolatedEffect.h"
+
+#define INTERPOLATED_TEST_LEDS    4
+#define INTERPOLATED_TEST_A       CRGB(200, 100, 0)
+#define INTERPOLATED_TEST_B       CRGB(0, 100, 200)
+
+//
+// Fills the strip with A on even frames and B on odd frames.
+//
+class AlternatingEffect : public IEffect
+{
+  public:
+    AlternatingEffect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength) : IEffect(leds, numberOfLeds, frameLength)
+    {
+    }
+
+    bool reset()
+    {
+      this->frames = 0;
+      return IEffect::reset();
+    }
+
+    uint32_t frames = 0;
+
+  protected:
+    bool onAnimate()
+    {
+      CRGB color = (this->frames++ % 2) == 0 ? INTERPOLATED_TEST_A : INTERPOLATED_TEST_B;
+
+      for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+      {
+        this->_leds[i] = color;
+      }
+
+      return true;
+    }
+};
+
+//
+// Returns true if every LED is the specified color.
+//
+static bool all(CRGB* leds, CRGB color)
+{
+  bool returnValue = true;
+
+  for (uint8_t i = 0; i < INTERPOLATED_TEST_LEDS; i++)
+  {
+    returnValue = returnValue && leds[i] == color;
+  }
+
+  return returnValue;
+}
+
+int main()
+{
+  static CRGB leds[INTERPOLATED_TEST_LEDS];
+  static CRGB frame[INTERPOLATED_TEST_LEDS];
+
+  ManualClock clock;
+  clock.time = 1000;
+  Clock::use(&clock);
+
+  AlternatingEffect* alternating = new AlternatingEffect(frame, INTERPOLATED_TEST_LEDS, 100);
+  InterpolatedEffect effect(leds, INTERPOLATED_TEST_LEDS, 10, alternating, frame);
+  effect.reset();
+
+  //
+  // The first frame starts from the cleared strip: at the start
+  // of the effect's frame nothing is lit, half way through the
+  // strip is half of A and at the end it is A.
+  //
+  CHECK(effect.animate());
+  CHECK(alternating->frames == 1);
+  CHECK(all(leds, CRGB(0, 0, 0)));
+
+  clock.advance(50);
+  CHECK(effect.animate());
+  CHECK(all(leds, CRGB(100, 50, 0)));
+
+  //
+  // Nothing moved, so nothing is drawn.
+  //
+  CHECK(!effect.animate());
+
+  //
+  // The next frame blends from what was displayed (half of A),
+  // not from A: half way it is half way between the two.
+  //
+  clock.advance(50);
+  CHECK(effect.animate());
+  CHECK(alternating->frames == 2);
+  CHECK(all(leds, CRGB(100, 50, 0)));
+
+  clock.advance(50);
+  CHECK(effect.animate());
+  CHECK(all(leds, blend(CRGB(100, 50, 0), INTERPOLATED_TEST_B, 128)));
+  CHECK(all(leds, CRGB(50, 75, 100)));
+
+  //
+  // The last blend of the frame is almost all B.
+  //
+  clock.advance(49);
+  CHECK(effect.animate());
+  CHECK(alternating->frames == 2);
+  CHECK(all(leds, blend(CRGB(100, 50, 0), INTERPOLATED_TEST_B, 253)));
+
+  //
+  // Reset clears the strip and restarts the effect, so the
+  // next blend starts from black again.
+  //
+  CHECK(effect.reset());
+  CHECK(all(leds, CRGB(0, 0, 0)));
+  CHECK(all(frame, CRGB(0, 0, 0)));
+  CHECK(alternating->frames == 0);
+
+  clock.advance(101);
+  CHECK(effect.animate());
+  CHECK(alternating->frames == 1);
+  CHECK(all(leds, CRGB(0, 0, 0)));
+
+  clock.advance(50);
+  CHECK(effect.animate());
+  CHECK(all(leds, CRGB(100, 50, 0)));
+
+  delete alternating;
+  Clock::use(NULL);
+
+  return CHECK_RESULT();
+}
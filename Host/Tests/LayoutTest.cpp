@@ -0,0 +1,173 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "IEffect2D.h"
+
+//
+// Draws single LEDs in logical space so the mapping used
+// by IEffect2D::setLed() can be checked.
+//
+class PointEffect : public IEffect2D
+{
+  public:
+    PointEffect(CRGB *leds, Layout *layout) : IEffect2D(leds, layout)
+    {
+    }
+
+    void draw(int32_t x, int32_t y, CRGB rgb)
+    {
+      this->setLed(x, y, rgb);
+    }
+};
+
+//
+// Row-major: every row runs left to right.
+//
+static void testMatrix()
+{
+  Layout* layout = Layout::matrix(4, 3, false);
+
+  CHECK(layout->numberOfLeds == 12);
+  CHECK(layout->index(0, 0) == 0);
+  CHECK(layout->index(3, 0) == 3);
+  CHECK(layout->index(0, 1) == 4);
+  CHECK(layout->index(3, 1) == 7);
+  CHECK(layout->index(2, 2) == 10);
+  CHECK(layout->x[7] == 255 && layout->y[7] == 127);
+
+  delete layout;
+}
+
+//
+// Serpentine: the odd rows run right to left.
+//
+static void testSerpentine()
+{
+  Layout* layout = Layout::matrix(4, 3, true);
+
+  CHECK(layout->index(0, 0) == 0);
+  CHECK(layout->index(3, 0) == 3);
+  CHECK(layout->index(0, 1) == 7);
+  CHECK(layout->index(1, 1) == 6);
+  CHECK(layout->index(3, 1) == 4);
+  CHECK(layout->index(0, 2) == 8);
+  CHECK(layout->index(3, 2) == 11);
+
+  //
+  // The positions follow the logical position, not the wiring.
+  //
+  CHECK(layout->x[4] == 255 && layout->y[4] == 127);
+  CHECK(layout->x[7] == 0 && layout->y[7] == 127);
+
+  delete layout;
+}
+
+//
+// A ring is a single row around a circle.
+//
+static void testRing()
+{
+  Layout* layout = Layout::ring(8);
+
+  CHECK(layout->width == 8 && layout->height == 1);
+
+  for (int32_t i = 0; i < 8; i++)
+  {
+    CHECK(layout->index(i, 0) == i);
+  }
+
+  CHECK(layout->x[0] == 255 && layout->y[0] == 127);
+  CHECK(layout->x[2] == 127 && layout->y[2] == 255);
+  CHECK(layout->x[4] == 0 && layout->y[4] == 127);
+
+  delete layout;
+}
+
+//
+// Positions outside the layout, or without an LED, have no
+// index and are ignored when drawing.
+//
+static void testOutOfRange()
+{
+  static CRGB leds[12];
+
+  Layout* layout = Layout::matrix(4, 3, true);
+
+  CHECK(layout->index(-1, 0) == -1);
+  CHECK(layout->index(4, 0) == -1);
+  CHECK(layout->index(0, -1) == -1);
+  CHECK(layout->index(0, 3) == -1);
+
+  //
+  // An irregular layout leaves unmapped positions empty, and
+  // an index past the last LED is not mapped.
+  //
+  Layout* irregular = new Layout(3, 3, 5);
+  irregular->map(1, 1, 4);
+  irregular->map(2, 2, 5);
+
+  CHECK(irregular->index(1, 1) == 4);
+  CHECK(irregular->index(0, 0) == -1);
+  CHECK(irregular->index(2, 2) == -1);
+
+  PointEffect effect(leds, layout);
+  effect.draw(1, 1, CRGB::Red);
+  effect.draw(-1, 1, CRGB::Blue);
+  effect.draw(4, 2, CRGB::Blue);
+
+  CHECK(leds[6] == CRGB(CRGB::Red));
+
+  for (uint8_t i = 0; i < 12; i++)
+  {
+    CHECK(i == 6 || leds[i] == CRGB(0, 0, 0));
+  }
+
+  delete irregular;
+  delete layout;
+}
+
+//
+// A matrix with more LEDs than 16-bit indexes can hold is
+// rejected rather than wrapping onto LAYOUT_NONE.
+//
+static void testOversize()
+{
+  CHECK(Layout::matrix(256, 256, false) == NULL);
+  CHECK(Layout::matrix(65535, 2, true) == NULL);
+
+  Layout* layout = Layout::matrix(65535, 1, false);
+  CHECK(layout != NULL);
+  CHECK(layout->numberOfLeds == LAYOUT_MAXIMUM_LEDS);
+  CHECK(layout->index(65534, 0) == 65534);
+
+  delete layout;
+}
+
+int main()
+{
+  testMatrix();
+  testSerpentine();
+  testRing();
+  testOutOfRange();
+  testOversize();
+
+  return CHECK_RESULT();
+}
@@ -0,0 +1,172 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "Clock.h"
+#include "ColorWheelStripeEffect.h"
+#include "PlasmaEffect.h"
+#include "SingleColorEffect.h"
+#include "TailEffect.h"
+
+#define LOCKSTEP_TEST_LEDS    30
+
+static CRGB _first[LOCKSTEP_TEST_LEDS];
+static CRGB _second[LOCKSTEP_TEST_LEDS];
+
+//
+// Runs two copies of an effect, as on two controllers sharing a
+// clock, with the second started later, and returns the number of
+// ms after the second started that the two showed different LEDs.
+// The clock steps back and forward part way through and the second
+// misses some frames, as when its loop() is held up.
+//
+template <class TEffect>
+static uint32_t lockstep(TEffect &first, TEffect &second, uint64_t start)
+{
+  uint32_t different = 0;
+  bool started = false;
+  bool stepped = false;
+
+  ManualClock clock;
+  Clock::use(&clock);
+
+  memset((void*)_first, 0, sizeof(_first));
+  memset((void*)_second, 0, sizeof(_second));
+  first.reset();
+
+  while (clock.time < 20000)
+  {
+    if (clock.time == start)
+    {
+      second.reset();
+      started = true;
+    }
+
+    first.animate();
+
+    if (started)
+    {
+      if (clock.time < 9000 || clock.time > 9100)
+      {
+        second.animate();
+        different += memcmp(_first, _second, sizeof(_first)) != 0 ? 1 : 0;
+      }
+    }
+
+    if (clock.time == 12000 && !stepped)
+    {
+      clock.time = 10500;
+      stepped = true;
+    }
+    else if (clock.time == 15000)
+    {
+      clock.time = 17000;
+    }
+    else
+    {
+      clock.advance(1);
+    }
+  }
+
+  Clock::use(NULL);
+
+  return different;
+}
+
+static void testSingleColor()
+{
+  SingleColorEffect first(_first, LOCKSTEP_TEST_LEDS, 16, CRGB::Red);
+  SingleColorEffect second(_second, LOCKSTEP_TEST_LEDS, 16, CRGB::Red);
+
+  CHECK(lockstep(first, second, 4321) == 0);
+}
+
+static void testTail()
+{
+  TailEffect first(_first, LOCKSTEP_TEST_LEDS, 25, CRGB::Blue, 5, 0.5);
+  TailEffect second(_second, LOCKSTEP_TEST_LEDS, 25, CRGB::Blue, 5, 0.5);
+
+  CHECK(lockstep(first, second, 7777) == 0);
+}
+
+static void testColorWheelStripe()
+{
+  ColorWheelStripeEffect first(_first, LOCKSTEP_TEST_LEDS, 10, 4);
+  ColorWheelStripeEffect second(_second, LOCKSTEP_TEST_LEDS, 10, 4);
+
+  CHECK(lockstep(first, second, 3003) == 0);
+}
+
+static void testPlasma()
+{
+  PlasmaEffect first(_first, LOCKSTEP_TEST_LEDS, 20, 16);
+  PlasmaEffect second(_second, LOCKSTEP_TEST_LEDS, 20, 16);
+
+  CHECK(lockstep(first, second, 5555) == 0);
+
+  StaticPlasmaEffect staticFirst(_first, LOCKSTEP_TEST_LEDS, 20, 16);
+  StaticPlasmaEffect staticSecond(_second, LOCKSTEP_TEST_LEDS, 20, 16);
+
+  CHECK(lockstep(staticFirst, staticSecond, 5555) == 0);
+}
+
+//
+// An effect restored from saved state (see Persistence) carries
+// on from where it was saved rather than jumping to the clock.
+//
+static void testResume()
+{
+  ManualClock clock;
+  Clock::use(&clock);
+
+  SingleColorEffect effect(_first, LOCKSTEP_TEST_LEDS, 16, CRGB::Red);
+  uint8_t state[EFFECT_STATE_LENGTH];
+  int32_t index;
+
+  clock.time = 16 * 7;
+  effect.reset();
+  effect.animate();
+
+  uint8_t length = effect.saveState(state);
+  memcpy(&index, &state[4], sizeof(index));
+  CHECK(index == 8);
+
+  clock.time = 16 * 20;
+  effect.reset();
+  CHECK(effect.restoreState(state, length));
+  CHECK(effect.animate());
+
+  effect.saveState(state);
+  memcpy(&index, &state[4], sizeof(index));
+  CHECK(index == 9);
+
+  Clock::use(NULL);
+}
+
+int main()
+{
+  testSingleColor();
+  testTail();
+  testColorWheelStripe();
+  testPlasma();
+  testResume();
+
+  return CHECK_RESULT();
+}
@@ -0,0 +1,229 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <HostUdp.h>
+#include "Check.h"
+#include "DdpOutput.h"
+#include "DdpReceiver.h"
+#include "E131Output.h"
+
+#define OUTPUT_TEST_LEDS    1000
+#define OUTPUT_TEST_PORT    41048
+
+//
+// Receives packets until one arrives or a second passes.
+//
+static int receive(HostUdp& udp)
+{
+  int returnValue = 0;
+  unsigned long start = millis();
+
+  while ((returnValue = udp.parsePacket()) == 0 && millis() - start < 1000)
+  {
+    delayMicroseconds(100);
+  }
+
+  return returnValue;
+}
+
+//
+// Sends frames over loopback and checks that the receiver holds
+// the same frame and that only changed packets are sent.
+//
+static void testDdp()
+{
+  static CRGB sent[OUTPUT_TEST_LEDS];
+  static CRGB received[OUTPUT_TEST_LEDS];
+
+  HostUdp sender;
+  HostUdp listener;
+  CHECK(listener.begin(OUTPUT_TEST_PORT) == 1);
+
+  IOutput* output = new DdpOutput(sent, OUTPUT_TEST_LEDS, &sender, IPAddress(127, 0, 0, 1), OUTPUT_TEST_PORT);
+  DdpReceiver receiver(received, OUTPUT_TEST_LEDS, &listener);
+  ((DdpOutput*)output)->timecode = true;
+
+  for (uint32_t i = 0; i < OUTPUT_TEST_LEDS; i++)
+  {
+    sent[i] = CRGB((uint8_t)i, (uint8_t)(i >> 2), (uint8_t)(255 - i));
+  }
+
+  //
+  // The first frame sends every packet (1000 LEDs is 3 packets).
+  //
+  CHECK(output->show());
+
+  uint32_t frames = 0;
+  unsigned long start = millis();
+
+  while (frames == 0 && millis() - start < 1000)
+  {
+    frames += receiver.poll() ? 1 : 0;
+  }
+
+  CHECK(frames == 1);
+  CHECK(receiver.packets == 3);
+  CHECK(receiver.invalid == 0);
+  CHECK(memcmp(sent, received, sizeof(sent)) == 0);
+
+  //
+  // Nothing changed so nothing is sent.
+  //
+  CHECK(!output->show());
+
+  //
+  // Only the packet holding the changed LED is sent.
+  //
+  sent[700] = CRGB(1, 2, 3);
+  CHECK(output->show());
+  start = millis();
+
+  while (!receiver.poll() && millis() - start < 1000)
+  {
+  }
+
+  CHECK(receiver.packets == 4);
+  CHECK(receiver.frames == 2);
+  CHECK(receiver.lost == 0);
+  CHECK(received[700] == CRGB(1, 2, 3));
+
+  //
+  // A packet going from black to white is sent (the sums
+  // of 0x00 and 0xFF are equal modulo 255).
+  //
+  for (uint32_t i = 0; i < 480; i++)
+  {
+    sent[i] = CRGB(0, 0, 0);
+  }
+
+  output->show();
+  start = millis();
+
+  while (!receiver.poll() && millis() - start < 1000)
+  {
+  }
+
+  for (uint32_t i = 0; i < 480; i++)
+  {
+    sent[i] = CRGB(255, 255, 255);
+  }
+
+  CHECK(output->show());
+  start = millis();
+
+  while (!receiver.poll() && millis() - start < 1000)
+  {
+  }
+
+  CHECK(receiver.frames == 4);
+  CHECK(received[0] == CRGB(255, 255, 255));
+  CHECK(received[479] == CRGB(255, 255, 255));
+
+  //
+  // Nothing is sent again until a second has passed,
+  // then refresh() sends every packet.
+  //
+  CHECK(!output->refresh());
+  advanceTime(PACKET_REFRESH_INTERVAL);
+  CHECK(output->refresh());
+  start = millis();
+
+  while (!receiver.poll() && millis() - start < 1000)
+  {
+  }
+
+  CHECK(receiver.packets == 9);
+  CHECK(!output->refresh());
+
+  //
+  // Deleting through the base releases the packet tracking.
+  //
+  delete output;
+}
+
+//
+// Checks the layout of the E1.31 packets for each universe.
+//
+static void testE131()
+{
+  static CRGB leds[OUTPUT_TEST_LEDS];
+
+  HostUdp sender;
+  HostUdp listener;
+  CHECK(listener.begin(OUTPUT_TEST_PORT + 1) == 1);
+
+  for (uint32_t i = 0; i < OUTPUT_TEST_LEDS; i++)
+  {
+    leds[i] = CRGB((uint8_t)(i * 3), (uint8_t)(i * 5), (uint8_t)(i * 7));
+  }
+
+  E131Output output(leds, OUTPUT_TEST_LEDS, &sender, 7, IPAddress(127, 0, 0, 1), OUTPUT_TEST_PORT + 1);
+  CHECK(output.show());
+
+  //
+  // 1000 LEDs is 6 universes (5 x 170 + 150).
+  //
+  for (uint16_t universe = 0; universe < 6; universe++)
+  {
+    uint8_t packet[E131_HEADER_LENGTH + E131_CHANNELS];
+    int length = receive(listener);
+    uint16_t pixels = universe < 5 ? 170 : 150;
+
+    CHECK(length == E131_HEADER_LENGTH + (pixels * 3));
+    CHECK(listener.read(packet, sizeof(packet)) == length);
+    CHECK(memcmp(&packet[4], "ASC-E1.17", 9) == 0);
+    CHECK(((packet[E131_ROOT_LENGTH] & 0x0F) << 8 | packet[E131_ROOT_LENGTH + 1]) == length - E131_ROOT_LENGTH);
+    CHECK(((packet[E131_UNIVERSE] << 8) | packet[E131_UNIVERSE + 1]) == 7 + universe);
+    CHECK(packet[E131_PRIORITY] == E131_DEFAULT_PRIORITY);
+    CHECK(((packet[E131_PROPERTY_COUNT] << 8) | packet[E131_PROPERTY_COUNT + 1]) == (pixels * 3) + 1);
+    CHECK(packet[E131_HEADER_LENGTH - 1] == 0);
+    CHECK(memcmp(&packet[E131_HEADER_LENGTH], &leds[universe * 170], pixels * 3) == 0);
+  }
+
+  CHECK(!output.show());
+
+  //
+  // Only the changed universe is sent; its sequence number
+  // increases by one.
+  //
+  leds[400] = CRGB(1, 2, 3);
+  CHECK(output.show());
+
+  uint8_t packet[E131_HEADER_LENGTH + E131_CHANNELS];
+  CHECK(receive(listener) == E131_HEADER_LENGTH + E131_CHANNELS - 2);
+  listener.read(packet, sizeof(packet));
+  CHECK(((packet[E131_UNIVERSE] << 8) | packet[E131_UNIVERSE + 1]) == 9);
+  CHECK(packet[E131_SEQUENCE] == 1);
+
+  leds[0] = CRGB(1, 2, 3);
+  CHECK(output.show());
+  CHECK(receive(listener) > 0);
+  listener.read(packet, sizeof(packet));
+  CHECK(((packet[E131_UNIVERSE] << 8) | packet[E131_UNIVERSE + 1]) == 7);
+  CHECK(packet[E131_SEQUENCE] == 1);
+}
+
+int main()
+{
+  testDdp();
+  testE131();
+
+  return CHECK_RESULT();
+}
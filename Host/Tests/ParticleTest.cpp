@@ -0,0 +1,182 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "Clock.h"
+#include "ParticleEffect.h"
+
+#define PARTICLE_TEST_LEDS    10
+
+//
+// Emits nothing on its own so the test places every particle,
+// and exposes the number of live particles.
+//
+class TestParticles : public ParticleEffect
+{
+  public:
+    TestParticles(CRGB *leds, uint16_t capacity, uint8_t decay, uint8_t fade) : ParticleEffect(leds, PARTICLE_TEST_LEDS, 10, capacity, 0, decay, fade)
+    {
+    }
+
+    uint16_t count()
+    {
+      return this->_count;
+    }
+
+    uint32_t emits = 0;
+
+  protected:
+    void onEmit()
+    {
+      this->emits++;
+    }
+};
+
+//
+// Returns true if every LED except first and second is off.
+//
+static bool othersOff(CRGB* leds, int first, int second)
+{
+  bool returnValue = true;
+
+  for (int i = 0; i < PARTICLE_TEST_LEDS; i++)
+  {
+    returnValue = returnValue && (i == first || i == second || leds[i] == CRGB(0, 0, 0));
+  }
+
+  return returnValue;
+}
+
+//
+// A particle moves by its velocity each frame, loses its decay
+// in life and is split between the two LEDs it lies between.
+//
+static void testMove(ManualClock& clock)
+{
+  static CRGB leds[PARTICLE_TEST_LEDS];
+
+  TestParticles effect(leds, 4, 5, 0);
+  effect.reset();
+
+  CHECK(effect.emit(2 << 8, 128, 255, 0));
+  CHECK(effect.animate());
+  CHECK(effect.emits == 1);
+
+  CRGB rgb = CHSV(0, 255, 250);
+  CHECK(leds[2] == CRGB(rgb).nscale8(127));
+  CHECK(leds[3] == CRGB(rgb).nscale8(128));
+  CHECK(othersOff(leds, 2, 3));
+
+  //
+  // A whole LED later it lies on LED 3 alone.
+  //
+  clock.advance(10);
+  CHECK(effect.animate());
+
+  rgb = CHSV(0, 255, 245);
+  CHECK(leds[3] == CRGB(rgb).nscale8(255));
+  CHECK(othersOff(leds, 3, 3));
+}
+
+//
+// Particles are removed when their life runs out or they leave
+// the strip, and the pool does not grow past its capacity.
+//
+static void testLifetime(ManualClock& clock)
+{
+  static CRGB leds[PARTICLE_TEST_LEDS];
+
+  TestParticles effect(leds, 3, 100, 0);
+  effect.reset();
+
+  CHECK(effect.emit(5 << 8, 0, 200, 0));
+  CHECK(effect.emit(0, -256, 255, 96));
+  CHECK(effect.emit((PARTICLE_TEST_LEDS - 1) << 8, 256, 255, 160));
+  CHECK(!effect.emit(1 << 8, 0, 255, 0));
+  CHECK(effect.count() == 3);
+
+  //
+  // Both moving particles leave the strip.
+  //
+  clock.advance(10);
+  effect.animate();
+  CHECK(effect.count() == 1);
+  CHECK(leds[5] == CRGB(CHSV(0, 255, 100)));
+
+  //
+  // The last one runs out of life and the strip goes dark.
+  //
+  clock.advance(10);
+  effect.animate();
+  CHECK(effect.count() == 0);
+  CHECK(othersOff(leds, -1, -1));
+
+  //
+  // Its place in the pool can be used again.
+  //
+  CHECK(effect.emit(1 << 8, 0, 255, 0));
+  CHECK(effect.count() == 1);
+
+  effect.reset();
+  CHECK(effect.count() == 0);
+}
+
+//
+// With a fade the previous frame remains as a trail.
+//
+static void testTrail(ManualClock& clock)
+{
+  static CRGB leds[PARTICLE_TEST_LEDS];
+
+  TestParticles effect(leds, 1, 0, 128);
+  effect.reset();
+
+  for (int i = 0; i < PARTICLE_TEST_LEDS; i++)
+  {
+    leds[i] = CRGB(0, 0, 0);
+  }
+
+  CHECK(effect.emit(1 << 8, 256, 255, 0));
+  clock.advance(10);
+  effect.animate();
+
+  CRGB rgb = CHSV(0, 255, 255);
+  CHECK(leds[2] == rgb);
+
+  clock.advance(10);
+  effect.animate();
+  CHECK(leds[3] == rgb);
+  CHECK(leds[2] == CRGB(rgb).nscale8(128));
+}
+
+int main()
+{
+  ManualClock clock;
+  clock.time = 1000;
+  Clock::use(&clock);
+
+  testMove(clock);
+  testLifetime(clock);
+  testTrail(clock);
+
+  Clock::use(NULL);
+
+  return CHECK_RESULT();
+}
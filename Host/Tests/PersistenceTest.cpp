@@ -0,0 +1,190 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "Persistence.h"
+#include "SingleColorEffect.h"
+
+#define PERSISTENCE_TEST_LEDS   10
+
+static CRGB _leds[PERSISTENCE_TEST_LEDS];
+
+//
+// Saves a color change and returns true if it was written.
+//
+static bool save(Persistence& persistence, SingleColorEffect& effect, uint32_t color)
+{
+  effect.setParameter(PARAMETER_COLOR, color);
+  persistence.changed();
+  advanceTime(PERSISTENCE_DEBOUNCE);
+
+  return persistence.update(0, &effect);
+}
+
+//
+// Every change is written, including two snapshots with the same
+// CRC-8: black and 0x010700 differ by the CRC polynomial (0x107).
+// An unchanged snapshot is not written again, even after a restore.
+//
+static void testChanges()
+{
+  SingleColorEffect effect(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Black);
+  IEffect* effects[] = { &effect };
+  int current = 0;
+
+  Persistence persistence(0, PERSISTENCE_ALL_SLOTS);
+  CHECK(!persistence.restore(effects, 1, &current));
+
+  CHECK(save(persistence, effect, 0x000000));
+  CHECK(save(persistence, effect, 0x010700));
+  CHECK(save(persistence, effect, 0x000000));
+  CHECK(!save(persistence, effect, 0x000000));
+
+  Persistence restored(0, PERSISTENCE_ALL_SLOTS);
+  CHECK(restored.restore(effects, 1, &current));
+  CHECK(!save(restored, effect, 0x000000));
+  CHECK(save(restored, effect, 0x123456));
+}
+
+//
+// A restore selects the effect that was saved and gives it back
+// the color and position it had, even after the ring has wrapped
+// around several times.
+//
+static void testRestore()
+{
+  SingleColorEffect effect1(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Red);
+  SingleColorEffect effect2(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Green);
+  SingleColorEffect effect3(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Blue);
+  IEffect* effects[] = { &effect1, &effect2, &effect3 };
+  uint8_t saved[EFFECT_STATE_LENGTH];
+  uint8_t state[EFFECT_STATE_LENGTH];
+  int current = 0;
+
+  Persistence persistence(0, PERSISTENCE_ALL_SLOTS);
+  persistence.restore(effects, 3, &current);
+
+  uint32_t slots = persistence.length() / PERSISTENCE_SLOT_LENGTH;
+
+  for (uint32_t i = 0; i < 3 * slots; i++)
+  {
+    effect3.setParameter(PARAMETER_COLOR, 0x123400 + i);
+    persistence.changed();
+    advanceTime(PERSISTENCE_DEBOUNCE);
+    CHECK(persistence.update(2, &effect3));
+  }
+
+  //
+  // Animate the effect so it moves to the position of the
+  // clock's frame, then save it.
+  //
+  effect3.reset();
+
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    advanceTime(16);
+    effect3.animate();
+  }
+
+  int32_t position = (int32_t)(((Clock::now() / 16) + 1) % PERSISTENCE_TEST_LEDS);
+
+  persistence.changed();
+  advanceTime(PERSISTENCE_DEBOUNCE);
+  CHECK(persistence.update(2, &effect3));
+
+  uint8_t length = effect3.saveState(saved);
+  int32_t index;
+  memcpy(&index, &saved[4], sizeof(index));
+  CHECK(index == position);
+
+  //
+  // Restore into new effects, as after a power loss.
+  //
+  SingleColorEffect restored1(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Red);
+  SingleColorEffect restored2(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Green);
+  SingleColorEffect restored3(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Blue);
+  IEffect* restoredEffects[] = { &restored1, &restored2, &restored3 };
+
+  Persistence after(0, PERSISTENCE_ALL_SLOTS);
+  CHECK(after.restore(restoredEffects, 3, &current));
+  CHECK(current == 2);
+
+  CHECK(restored3.saveState(state) == length);
+  CHECK(memcmp(state, saved, length) == 0);
+  CHECK(CRGB(state[8], state[9], state[10]) == CRGB(0x123400 + (3 * slots) - 1));
+
+  //
+  // The effects that were not saved are left alone.
+  //
+  restored1.saveState(state);
+  CHECK(CRGB(state[8], state[9], state[10]) == CRGB(CRGB::Red));
+}
+
+//
+// The ring uses all of the EEPROM and a running effect saved
+// every interval for a simulated year writes each cell no more
+// than the ring spreads the saves over.
+//
+static void testWear()
+{
+  SingleColorEffect effect(_leds, PERSISTENCE_TEST_LEDS, 16, CRGB::Black);
+  IEffect* effects[] = { &effect };
+  int current = 0;
+
+  Persistence persistence(0, PERSISTENCE_ALL_SLOTS);
+  persistence.restore(effects, 1, &current);
+
+  CHECK(persistence.length() == (EEPROM.length() / PERSISTENCE_SLOT_LENGTH) * PERSISTENCE_SLOT_LENGTH);
+
+  uint32_t saves = 0;
+  uint32_t year = 365UL * 24 * 60 * 60 * 1000 / PERSISTENCE_INTERVAL;
+
+  memset(EEPROM.writes, 0, sizeof(EEPROM.writes));
+
+  for (uint32_t i = 0; i < year; i++)
+  {
+    effect.setParameter(PARAMETER_COLOR, i);
+    advanceTime(PERSISTENCE_INTERVAL);
+    saves += persistence.update(0, &effect) ? 1 : 0;
+  }
+
+  uint32_t worst = 0;
+
+  for (uint16_t i = 0; i < EEPROM.length(); i++)
+  {
+    worst = max(worst, EEPROM.writes[i]);
+  }
+
+  uint32_t slots = persistence.length() / PERSISTENCE_SLOT_LENGTH;
+
+  printf("%u slots, %u saves in a year, at most %u writes to a cell\n", slots, saves, worst);
+
+  CHECK(saves == year);
+  CHECK(worst <= (saves + slots - 1) / slots);
+}
+
+int main()
+{
+  testChanges();
+  testRestore();
+  testWear();
+
+  return CHECK_RESULT();
+}
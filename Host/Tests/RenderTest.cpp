@@ -0,0 +1,149 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <vector>
+#include "Check.h"
+#include "Clock.h"
+#include "RenderEngine.h"
+#include "PlasmaEffect.h"
+#include "SpinningRainbow.h"
+#include "ColorWheelStripeEffect.h"
+#include "TailEffect.h"
+
+#define RENDER_TEST_STRIPS    32
+#define RENDER_TEST_LEDS      60
+#define RENDER_TEST_FRAMES    200
+#define RENDER_TEST_THREADS   4
+
+//
+// Counts the frames shown.
+//
+class CountingOutput : public IOutput
+{
+  public:
+    CountingOutput(CRGB *leds, uint32_t numberOfLeds) : IOutput(leds, numberOfLeds)
+    {
+    }
+
+    bool show()
+    {
+      this->frames++;
+      return true;
+    }
+
+    uint32_t frames = 0;
+};
+
+//
+// A set of strips with a mix of effects and frame lengths, so
+// some strips are due on a frame and others are not.
+//
+class Strips
+{
+  public:
+    Strips(uint16_t numberOfThreads) : engine(RENDER_TEST_STRIPS, numberOfThreads)
+    {
+      for (uint16_t i = 0; i < RENDER_TEST_STRIPS; i++)
+      {
+        CRGB* strip = RenderEngine::createLeds(RENDER_TEST_LEDS);
+        IEffect* effect = NULL;
+
+        switch (i % 4)
+        {
+          case 0:
+            effect = new PlasmaEffect(strip, RENDER_TEST_LEDS, 16 + i, (uint8_t)(8 + i));
+            break;
+          case 1:
+            effect = new SpinningRainbow(strip, RENDER_TEST_LEDS, 30 + i);
+            break;
+          case 2:
+            effect = new ColorWheelStripeEffect(strip, RENDER_TEST_LEDS, 10 + i, 4);
+            break;
+          default:
+            effect = new TailEffect(strip, RENDER_TEST_LEDS, 20 + i, CRGB(0, 24, 210), 4, .65);
+            break;
+        }
+
+        this->leds.push_back(strip);
+        this->effects.push_back(effect);
+        this->outputs.push_back(new CountingOutput(strip, RENDER_TEST_LEDS));
+        this->engine.add(effect, this->outputs.back());
+      }
+
+      this->engine.reset();
+    }
+
+    ~Strips()
+    {
+      for (uint16_t i = 0; i < RENDER_TEST_STRIPS; i++)
+      {
+        delete this->outputs[i];
+        delete this->effects[i];
+        RenderEngine::destroyLeds(this->leds[i]);
+      }
+    }
+
+    RenderEngine engine;
+    std::vector<CRGB*> leds;
+    std::vector<IEffect*> effects;
+    std::vector<CountingOutput*> outputs;
+};
+
+//
+// Rendering through the thread pool draws and shows exactly
+// what rendering the strips one after another does.
+//
+int main()
+{
+  ManualClock clock;
+  Clock::use(&clock);
+
+  Strips serial(1);
+  Strips parallel(RENDER_TEST_THREADS);
+
+  uint32_t shown = 0;
+
+  for (uint32_t frame = 0; frame < RENDER_TEST_FRAMES; frame++)
+  {
+    clock.advance(7);
+
+    uint16_t serialShown = serial.engine.render();
+    uint16_t parallelShown = parallel.engine.render();
+
+    CHECK(serialShown == parallelShown);
+    shown += serialShown;
+
+    for (uint16_t i = 0; i < RENDER_TEST_STRIPS; i++)
+    {
+      CHECK(memcmp(serial.leds[i], parallel.leds[i], RENDER_TEST_LEDS * sizeof(CRGB)) == 0);
+      CHECK(serial.outputs[i]->frames == parallel.outputs[i]->frames);
+    }
+  }
+
+  //
+  // Some, but not all, strips are due on each frame.
+  //
+  CHECK(shown > RENDER_TEST_FRAMES);
+  CHECK(shown < RENDER_TEST_FRAMES * RENDER_TEST_STRIPS);
+
+  Clock::use(NULL);
+
+  return CHECK_RESULT();
+}
@@ -0,0 +1,239 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Check.h"
+#include "Sequencer.h"
+#include "Clock.h"
+#include "SingleColorEffect.h"
+
+#define SEQUENCER_TEST_LEDS     10
+
+//
+// Three one second cues played in a loop.
+//
+static const uint8_t SEQUENCER_TEST_SHOW[] PROGMEM =
+{
+  CUE_HEADER(3),
+  CUE(0, 1000, 0, CUE_CUT, 0, CUE_NONE, 0, CUE_NONE, 0),
+  CUE(1000, 1000, 1, CUE_CUT, 0, CUE_NONE, 0, CUE_NONE, 0),
+  CUE(2000, 1000, 2, CUE_CUT, 0, CUE_NONE, 0, CUE_NONE, 0)
+};
+
+//
+// Plays the show for 100 s with loop() running every 16 ms, which
+// does not divide the length of a cue, and checks the cue playing
+// is always the one the show has reached. Starting each cue when
+// loop() noticed the previous one ended would drift by up to a
+// frame per cue.
+//
+static void testNoDrift()
+{
+  static CRGB leds[SEQUENCER_TEST_LEDS];
+
+  ManualClock clock;
+  Clock::use(&clock);
+
+  IEffect effect1(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect effect2(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect effect3(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect* effects[] = { &effect1, &effect2, &effect3 };
+
+  Sequencer sequencer(effects, 3, SEQUENCER_TEST_SHOW);
+  CHECK(sequencer.valid());
+  CHECK(sequencer.start());
+
+  uint32_t wrong = 0;
+
+  while (clock.time < 100000)
+  {
+    clock.advance(16);
+    sequencer.animate();
+    wrong += sequencer.cue != (clock.time / 1000) % 3 ? 1 : 0;
+  }
+
+  CHECK(sequencer.playing);
+  CHECK(wrong == 0);
+
+  Clock::use(NULL);
+}
+
+//
+// seek() starts a cue from its beginning; a cue that does not exist
+// leaves the current one playing.
+//
+static void testSeek()
+{
+  static CRGB leds[SEQUENCER_TEST_LEDS];
+
+  ManualClock clock;
+  Clock::use(&clock);
+
+  IEffect effect1(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect effect2(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect effect3(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect* effects[] = { &effect1, &effect2, &effect3 };
+
+  Sequencer sequencer(effects, 3, SEQUENCER_TEST_SHOW);
+  CHECK(sequencer.start());
+
+  clock.advance(300);
+  sequencer.animate();
+  CHECK(sequencer.seek(2));
+  CHECK(sequencer.cue == 2);
+
+  //
+  // The whole of cue 2 plays before the show loops to cue 0.
+  //
+  clock.advance(999);
+  sequencer.animate();
+  CHECK(sequencer.cue == 2);
+
+  clock.advance(1);
+  sequencer.animate();
+  CHECK(sequencer.cue == 0);
+
+  CHECK(!sequencer.seek(3));
+  CHECK(sequencer.cue == 0);
+  CHECK(sequencer.playing);
+
+  Clock::use(NULL);
+}
+
+//
+// seekTime() finds the cue playing at a time and starts it part
+// way through, so the next cue starts when it would have if the
+// show had played from the start.
+//
+static void testSeekTime()
+{
+  static CRGB leds[SEQUENCER_TEST_LEDS];
+
+  ManualClock clock;
+  Clock::use(&clock);
+
+  IEffect effect1(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect effect2(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect effect3(leds, SEQUENCER_TEST_LEDS, 16);
+  IEffect* effects[] = { &effect1, &effect2, &effect3 };
+
+  Sequencer sequencer(effects, 3, SEQUENCER_TEST_SHOW);
+  CHECK(sequencer.start());
+
+  static const struct
+  {
+    uint32_t time;
+    uint16_t cue;
+    uint32_t remaining;
+  } TIMES[] =
+  {
+    { 0, 0, 1000 },
+    { 999, 0, 1 },
+    { 1000, 1, 1000 },
+    { 1500, 1, 500 },
+    { 2999, 2, 1 }
+  };
+
+  for (size_t i = 0; i < sizeof(TIMES) / sizeof(TIMES[0]); i++)
+  {
+    CHECK(sequencer.seekTime(TIMES[i].time));
+    CHECK(sequencer.cue == TIMES[i].cue);
+
+    clock.advance(TIMES[i].remaining - 1);
+    sequencer.animate();
+    CHECK(sequencer.cue == TIMES[i].cue);
+
+    clock.advance(1);
+    sequencer.animate();
+    CHECK(sequencer.cue == (TIMES[i].cue + 1) % 3);
+  }
+
+  //
+  // Past the end of the show.
+  //
+  CHECK(sequencer.seek(1));
+  CHECK(!sequencer.seekTime(3000));
+  CHECK(sequencer.cue == 1);
+
+  Clock::use(NULL);
+}
+
+//
+// A cue's parameters only last for the cue: the effect has its
+// own color and frame length back when the next cue starts and
+// when the show stops.
+//
+static void testParameters()
+{
+  static CRGB leds[SEQUENCER_TEST_LEDS];
+
+  static const uint8_t SHOW[] PROGMEM =
+  {
+    CUE_HEADER(3),
+    CUE(0, 1000, 0, CUE_CUT, 0, PARAMETER_COLOR, 0xFF0000, PARAMETER_FRAME_LENGTH, 50),
+    CUE(1000, 1000, 0, CUE_CUT, 0, CUE_NONE, 0, CUE_NONE, 0),
+    CUE(2000, 1000, 0, CUE_CUT, 0, PARAMETER_COLOR, 0x0000FF, CUE_NONE, 0)
+  };
+
+  ManualClock clock;
+  Clock::use(&clock);
+
+  SingleColorEffect effect(leds, SEQUENCER_TEST_LEDS, 16, CRGB(0x00FF00));
+  IEffect* effects[] = { &effect };
+  uint8_t state[EFFECT_STATE_LENGTH];
+
+  Sequencer sequencer(effects, 1, SHOW);
+  sequencer.loop = false;
+  CHECK(sequencer.start());
+
+  effect.saveState(state);
+  CHECK(effect.frameLength == 50);
+  CHECK(CRGB(state[8], state[9], state[10]) == CRGB(0xFF0000));
+
+  clock.advance(1000);
+  sequencer.animate();
+  effect.saveState(state);
+  CHECK(sequencer.cue == 1);
+  CHECK(effect.frameLength == 16);
+  CHECK(CRGB(state[8], state[9], state[10]) == CRGB(0x00FF00));
+
+  clock.advance(1000);
+  sequencer.animate();
+  effect.saveState(state);
+  CHECK(sequencer.cue == 2);
+  CHECK(CRGB(state[8], state[9], state[10]) == CRGB(0x0000FF));
+
+  clock.advance(1000);
+  sequencer.animate();
+  effect.saveState(state);
+  CHECK(!sequencer.playing);
+  CHECK(CRGB(state[8], state[9], state[10]) == CRGB(0x00FF00));
+
+  Clock::use(NULL);
+}
+
+int main()
+{
+  testNoDrift();
+  testSeek();
+  testSeekTime();
+  testParameters();
+
+  return CHECK_RESULT();
+}
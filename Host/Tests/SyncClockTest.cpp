@@ -0,0 +1,207 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <random>
+#include <thread>
+#include <HostUdp.h>
+#include "Check.h"
+#include "SyncClock.h"
+
+#define SYNC_CLOCK_TEST_PORT    41050
+
+//
+// A follower that has been running longer than the leader steps
+// back to the leader's time instead of holding until it catches up.
+//
+static void testStep()
+{
+  HostUdp udp;
+  SyncClock follower(&udp, IPAddress(127, 0, 0, 1), SYNC_CLOCK_TEST_PORT, false);
+
+  advanceTime(20000);
+  uint64_t before = follower.now();
+  uint64_t local = Clock::local();
+
+  follower.sample(local - 10000, local);
+
+  uint64_t after = follower.now();
+  CHECK(after < before);
+  CHECK(after + 10000 >= before && after + 10000 <= before + 5);
+
+  advanceTime(100);
+  CHECK(follower.now() >= after + 100);
+}
+
+//
+// A small correction back holds the time instead.
+//
+static void testHold()
+{
+  HostUdp udp;
+  SyncClock follower(&udp, IPAddress(127, 0, 0, 1), SYNC_CLOCK_TEST_PORT, false);
+
+  uint64_t local = Clock::local();
+  follower.sample(local, local);
+  uint64_t before = follower.now();
+
+  for (uint8_t i = 0; i < SYNC_WINDOW; i++)
+  {
+    follower.sample(local - 20, local);
+  }
+
+  CHECK(follower.now() >= before);
+}
+
+//
+// The leader's broadcasts reach a follower over loopback.
+//
+static void testUdp()
+{
+  HostUdp leaderUdp;
+  HostUdp followerUdp;
+  CHECK(followerUdp.begin(SYNC_CLOCK_TEST_PORT) == 1);
+
+  SyncClock leader(&leaderUdp, IPAddress(127, 0, 0, 1), SYNC_CLOCK_TEST_PORT, true);
+  SyncClock follower(&followerUdp, IPAddress(127, 0, 0, 1), SYNC_CLOCK_TEST_PORT, false);
+
+  CHECK(leader.update());
+
+  unsigned long start = millis();
+
+  while (!follower.update() && millis() - start < 1000)
+  {
+    delayMicroseconds(100);
+  }
+
+  //
+  // Both share the same local clock so the offset is only the
+  // time the packet took.
+  //
+  CHECK(follower.synchronized);
+  CHECK(follower.offset() <= 0 && follower.offset() > -50);
+}
+
+//
+// Render threads read the time while samples are added.
+//
+static void testThreads()
+{
+  HostUdp udp;
+  SyncClock follower(&udp, IPAddress(127, 0, 0, 1), SYNC_CLOCK_TEST_PORT, false);
+  std::atomic<uint8_t> running(4);
+  std::atomic<uint32_t> backwards(0);
+  std::vector<std::thread> threads;
+
+  Clock::use(&follower);
+
+  for (uint8_t t = 0; t < 4; t++)
+  {
+    threads.push_back(std::thread([&]()
+    {
+      uint64_t last = 0;
+
+      for (uint32_t i = 0; i < 100000; i++)
+      {
+        uint64_t now = Clock::now();
+        backwards += now < last ? 1 : 0;
+        last = now;
+      }
+
+      running--;
+    }));
+  }
+
+  for (uint32_t i = 0; running > 0; i++)
+  {
+    uint64_t local = Clock::local();
+    follower.sample(local + (i % 7), local);
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  Clock::use(NULL);
+
+  CHECK(backwards == 0);
+}
+
+//
+// Three followers with different crystals receive the leader's
+// time once a second with up to 30 ms of random delay for 20
+// simulated minutes. Each must end up within a few ms of the
+// leader. The skew estimate is only as good as the best sample
+// of each window (a few ms in 8 s) so it is checked loosely.
+//
+static void testJitter()
+{
+  const int32_t skews[] = { -3000, 0, 500 };
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int> delay(0, 30);
+
+  printf("skew ppm  estimated  residual ms\n");
+
+  for (int32_t skew : skews)
+  {
+    HostUdp udp;
+    SyncClock follower(&udp, IPAddress(127, 0, 0, 1), SYNC_CLOCK_TEST_PORT, false);
+    uint64_t start = Clock::local();
+
+    //
+    // The leader's time for a local time: it started 12 s
+    // later and runs at a different rate.
+    //
+    auto leaderTime = [&](uint64_t local)
+    {
+      int64_t elapsed = (int64_t)(local - start);
+      return (uint64_t)(elapsed + ((elapsed * skew) / 1000000) + 1000000);
+    };
+
+    for (uint16_t i = 0; i < 1200; i++)
+    {
+      advanceTime(1000);
+
+      uint64_t local = Clock::local();
+      follower.sample(leaderTime(local - delay(random)), local);
+    }
+
+    advanceTime(500);
+
+    int64_t residual = (int64_t)(follower.now() - leaderTime(Clock::local()));
+
+    printf("%8d  %9d  %11lld\n", skew, follower.skew, (long long)residual);
+
+    CHECK(residual >= -5 && residual <= 5);
+    CHECK(follower.skew >= skew - 500 && follower.skew <= skew + 500);
+  }
+}
+
+int main()
+{
+  testStep();
+  testHold();
+  testUdp();
+  testThreads();
+  testJitter();
+
+  return CHECK_RESULT();
+}
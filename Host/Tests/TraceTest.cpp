@@ -0,0 +1,333 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+#include "Check.h"
+#include "ControlPort.h"
+#include "Trace.h"
+
+//
+// A stream that keeps what is written so it can be read back.
+//
+class MemoryStream : public Stream
+{
+  public:
+    int available()
+    {
+      return (int)(this->data.size() - this->_position);
+    }
+
+    int read()
+    {
+      return this->_position < this->data.size() ? this->data[this->_position++] : -1;
+    }
+
+    int peek()
+    {
+      return this->_position < this->data.size() ? this->data[this->_position] : -1;
+    }
+
+    size_t write(uint8_t value)
+    {
+      this->data.push_back(value);
+      return 1;
+    }
+
+    std::vector<uint8_t> data;
+
+  protected:
+    size_t _position = 0;
+};
+
+//
+// Appends an event to a binary dump.
+//
+static void addEvent(std::vector<uint8_t>& dump, uint32_t start, uint32_t duration, uint8_t phase, uint8_t thread = 0)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    dump.push_back((uint8_t)(start >> (i * 8)));
+  }
+
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    dump.push_back((uint8_t)(duration >> (i * 8)));
+  }
+
+  dump.push_back(phase);
+  dump.push_back(thread);
+}
+
+//
+// Returns the "tid" of each event in Chrome trace JSON.
+//
+static std::vector<int> threadIds(const char* json)
+{
+  std::vector<int> returnValue;
+
+  for (const char* p = strstr(json, "\"tid\":"); p != NULL; p = strstr(p + 1, "\"tid\":"))
+  {
+    returnValue.push_back(atoi(p + 6));
+  }
+
+  return returnValue;
+}
+
+//
+// Returns the "ts" of each event in Chrome trace JSON.
+//
+static std::vector<double> timestamps(const char* json)
+{
+  std::vector<double> returnValue;
+
+  for (const char* p = strstr(json, "\"ts\":"); p != NULL; p = strstr(p + 1, "\"ts\":"))
+  {
+    returnValue.push_back(atof(p + 5));
+  }
+
+  return returnValue;
+}
+
+//
+// Starts are unwrapped across the 32-bit wrap, a long gap between
+// kept frames and an enclosing scope recorded after its contents.
+//
+static void testChrome()
+{
+  std::vector<uint8_t> dump = { 'T', 'R', TRACE_VERSION, 0, 5, 0, 0x40, 0x42, 0x0F, 0x00 };
+  addEvent(dump, 0xFFFFFF00, 10, TRACE_ANIMATE);
+  addEvent(dump, 0x00000100, 10, TRACE_ANIMATE);
+  addEvent(dump, 0x00000080, 500, TRACE_SHOW);
+  addEvent(dump, 0x00000080 + 3000000, 10, TRACE_ANIMATE);
+  addEvent(dump, 0x00000080 + 300000000, 10, TRACE_ANIMATE, 3);
+
+  CHECK(Trace::load(dump.data(), (uint32_t)dump.size()));
+
+  char* json = NULL;
+  size_t length = 0;
+  FILE* file = open_memstream(&json, &length);
+  Trace::writeChrome(file);
+  fclose(file);
+
+  std::vector<double> ts = timestamps(json);
+  CHECK(ts.size() == 5);
+
+  if (ts.size() == 5)
+  {
+    CHECK(ts[0] == 0.0);
+    CHECK(ts[1] == 512.0);
+    CHECK(ts[2] == 384.0);
+    CHECK(ts[3] == 384.0 + 3000000.0);
+    CHECK(ts[4] == 384.0 + 300000000.0);
+  }
+
+  std::vector<int> tids = threadIds(json);
+  CHECK(tids.size() == 5 && tids[0] == 1 && tids[4] == 4);
+
+  free(json);
+}
+
+//
+// Render threads each record more events in a pass than a single
+// pending buffer held before; all of them are kept, with the
+// thread that recorded them.
+//
+static void testPass()
+{
+  Trace::begin();
+
+  std::atomic<uint8_t> recorded(0);
+  std::atomic<bool> ended(false);
+  std::vector<std::thread> threads;
+
+  for (uint8_t t = 0; t < 4; t++)
+  {
+    threads.push_back(std::thread([&]()
+    {
+      for (uint8_t i = 0; i < 20; i++)
+      {
+        TraceScope scope(TRACE_ANIMATE);
+      }
+
+      //
+      // A thread's events are dropped when it ends, so wait
+      // for the loop to end the frame.
+      //
+      recorded++;
+
+      while (!ended)
+      {
+        std::this_thread::yield();
+      }
+    }));
+  }
+
+  while (recorded < 4)
+  {
+    std::this_thread::yield();
+  }
+
+  Trace::record(TRACE_SHOW, Trace::ticks(), 1);
+  Trace::endFrame(true);
+  ended = true;
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  CHECK(Trace::count() == (4 * 20) + 1);
+
+  std::set<uint8_t> ids;
+
+  for (uint16_t i = 0; i < Trace::count(); i++)
+  {
+    ids.insert(Trace::event(i).thread);
+  }
+
+  CHECK(ids.size() == 5);
+}
+
+//
+// Render threads record events while the loop ends frames.
+//
+static void testThreads()
+{
+  Trace::begin();
+
+  std::vector<std::thread> threads;
+
+  for (uint8_t t = 0; t < 4; t++)
+  {
+    threads.push_back(std::thread([]()
+    {
+      for (uint32_t i = 0; i < 20000; i++)
+      {
+        TraceScope scope(TRACE_ANIMATE);
+      }
+    }));
+  }
+
+  for (uint32_t i = 0; i < 20000; i++)
+  {
+    Trace::record(TRACE_SHOW, Trace::ticks(), 1);
+    Trace::endFrame(true);
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  Trace::endFrame(true);
+
+  CHECK(Trace::count() == TRACE_EVENTS);
+
+  for (uint16_t i = 0; i < Trace::count(); i++)
+  {
+    CHECK(Trace::event(i).phase == TRACE_ANIMATE || Trace::event(i).phase == TRACE_SHOW);
+  }
+}
+
+//
+// The dump is sent as CONTROL_TRACE replies that a ControlPort
+// (or ControlClient) can decode and reassemble.
+//
+static std::vector<uint8_t> _received;
+static uint8_t _sequence = 0;
+static bool _ended = false;
+static bool _lost = false;
+
+static void handleCommand(uint8_t command, const uint8_t* payload, uint16_t length)
+{
+  if (command == CONTROL_TRACE && length > 0)
+  {
+    _lost = _lost || payload[0] != _sequence++;
+    _ended = length == 1;
+    _received.insert(_received.end(), payload + 1, payload + length);
+  }
+}
+
+static void testControl()
+{
+  Trace::begin();
+
+  for (uint16_t i = 0; i < 100; i++)
+  {
+    Trace::record(TRACE_ANIMATE, i * 1000, 0);
+    Trace::endFrame(true);
+  }
+
+  MemoryStream stream;
+  ControlPort port(&stream, CONTROL_MAXIMUM_FRAME);
+  port.setCommandHandler(handleCommand);
+
+  ControlWriter writer(&port, CONTROL_TRACE);
+  Trace::dump(writer);
+  writer.end();
+
+  port.poll((uint16_t)stream.data.size());
+
+  CHECK(port.errors == 0);
+  CHECK(_ended && !_lost);
+  CHECK(_received.size() == TRACE_HEADER_LENGTH + (100 * TRACE_EVENT_LENGTH));
+  CHECK(Trace::load(_received.data(), (uint32_t)_received.size()));
+  CHECK(Trace::count() == 100 && Trace::event(99).start == 99000);
+
+  //
+  // The same frames decoded one at a time as the client does.
+  //
+  uint8_t frame[CONTROL_MAXIMUM_ENCODED];
+  uint16_t start = 0;
+  uint32_t payload = 0;
+
+  for (uint16_t i = 0; i < stream.data.size(); i++)
+  {
+    if (stream.data[i] == 0)
+    {
+      //
+      // Skip the 0 sent before each frame.
+      //
+      if (i > start)
+      {
+        uint16_t decoded = ControlPort::decode(&stream.data[start], i - start, frame);
+        CHECK(decoded > 1 && frame[0] == CONTROL_TRACE);
+        payload += decoded - 2;
+      }
+
+      start = i + 1;
+    }
+  }
+
+  CHECK(payload == _received.size());
+}
+
+int main()
+{
+  testChrome();
+  testPass();
+  testThreads();
+  testControl();
+
+  return CHECK_RESULT();
+}
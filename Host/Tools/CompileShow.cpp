@@ -0,0 +1,83 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstdio>
+#include "CueCompiler.h"
+
+//
+// Compiles a text cue list into a show header for the sketch:
+//
+//  CompileShow <cue list> <header> <name>
+//
+// where name is the name of the array. Prints the error and
+// the line it is on if the cue list is not valid.
+//
+int main(int argc, char** argv)
+{
+  int returnValue = 1;
+
+  if (argc != 4)
+  {
+    fprintf(stderr, "usage: %s <cue list> <header> <name>\n", argv[0]);
+    return 2;
+  }
+
+  FILE* input = fopen(argv[1], "r");
+
+  if (input == NULL)
+  {
+    fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+    return 1;
+  }
+
+  FILE* output = fopen(argv[2], "w");
+
+  if (output == NULL)
+  {
+    fprintf(stderr, "%s: cannot create %s\n", argv[0], argv[2]);
+    fclose(input);
+    return 1;
+  }
+
+  CueCompiler compiler;
+
+  if (compiler.compile(input, output, argv[3]))
+  {
+    printf("%s: %u cues, %lu ms\n", argv[2], compiler.numberOfCues, (unsigned long)compiler.length);
+    returnValue = 0;
+  }
+  else
+  {
+    fprintf(stderr, "%s:%lu: %s\n", argv[1], (unsigned long)compiler.line, compiler.error);
+  }
+
+  fclose(input);
+  fclose(output);
+
+  //
+  // Do not leave a partial header behind.
+  //
+  if (returnValue != 0)
+  {
+    remove(argv[2]);
+  }
+
+  return returnValue;
+}
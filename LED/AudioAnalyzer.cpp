@@ -0,0 +1,166 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "AudioAnalyzer.h"
+
+//
+// Initialize the analyzer with an audio input, the size
+// of the transform and the number of bands.
+//
+AudioAnalyzer::AudioAnalyzer(AudioInput *input, uint16_t size, uint8_t numberOfBands)
+{
+  this->_input = input;
+  this->_fft = new Fft(size);
+  this->_real = new int16_t[size];
+  this->_imaginary = new int16_t[size];
+  this->_magnitudes = new uint16_t[size >> 1];
+  this->numberOfBands = constrain(numberOfBands, (uint8_t)1, (uint8_t)AUDIO_MAXIMUM_BANDS);
+
+  //
+  // Space the bands logarithmically between bin 1 (bin 0 is the
+  // DC offset) and the last bin. Every band has at least one bin.
+  // This is only calculated once so floating point is not a concern.
+  //
+  uint16_t bins = size >> 1;
+
+  for (uint8_t b = 0; b <= this->numberOfBands; b++)
+  {
+    uint16_t edge = (uint16_t)round(pow((double)bins, (double)b / this->numberOfBands));
+
+    if (b > 0 && edge <= this->_edges[b - 1])
+    {
+      edge = this->_edges[b - 1] + 1;
+    }
+
+    this->_edges[b] = min(edge, bins);
+  }
+
+  for (uint8_t b = 0; b < AUDIO_MAXIMUM_BANDS; b++)
+  {
+    this->bands[b] = 0;
+  }
+};
+
+//
+// Deconstructor: release the buffers.
+//
+AudioAnalyzer::~AudioAnalyzer()
+{
+  delete this->_fft;
+  delete[] this->_real;
+  delete[] this->_imaginary;
+  delete[] this->_magnitudes;
+  this->_input = NULL;
+};
+
+bool AudioAnalyzer::update()
+{
+  bool returnValue = false;
+  uint16_t size = this->_fft->size;
+
+  //
+  // Collect a full block of samples. When the effect runs slower
+  // than blocks arrive, skip to the newest full block so the
+  // input does not back up and the display does not fall behind.
+  //
+  this->_count += this->_input->read(&this->_real[this->_count], size - this->_count);
+
+  while (this->_count == size && this->_input->available() >= size)
+  {
+    this->_count = this->_input->read(this->_real, size);
+  }
+
+  if (this->_count == size)
+  {
+    this->_count = 0;
+
+    //
+    // Remove the DC offset (an ADC centered at mid-scale)
+    // and apply the window.
+    //
+    int32_t sum = 0;
+
+    for (uint16_t i = 0; i < size; i++)
+    {
+      sum += this->_real[i];
+    }
+
+    int32_t mean = sum / size;
+
+    //
+    // A full-scale sample minus the mean can be out of the
+    // 16-bit range, so subtract in 32 bits and saturate.
+    //
+    for (uint16_t i = 0; i < size; i++)
+    {
+      int32_t sample = (int32_t)this->_real[i] - mean;
+      this->_real[i] = (int16_t)constrain(sample, (int32_t)-32768, (int32_t)32767);
+      this->_imaginary[i] = 0;
+    }
+
+    this->_fft->window(this->_real);
+    this->_fft->transform(this->_real, this->_imaginary);
+    this->_fft->magnitudes(this->_real, this->_imaginary, this->_magnitudes);
+
+    //
+    // Average the bins of each band and find the loudest band.
+    //
+    uint16_t levels[AUDIO_MAXIMUM_BANDS];
+    uint16_t loudest = 0;
+    this->energy = 0;
+
+    for (uint8_t b = 0; b < this->numberOfBands; b++)
+    {
+      uint32_t bandSum = 0;
+
+      for (uint16_t i = this->_edges[b]; i < this->_edges[b + 1]; i++)
+      {
+        bandSum += this->_magnitudes[i];
+      }
+
+      this->energy += bandSum;
+      levels[b] = (uint16_t)(bandSum / max((uint16_t)1, (uint16_t)(this->_edges[b + 1] - this->_edges[b])));
+      loudest = max(loudest, levels[b]);
+    }
+
+    //
+    // Automatic gain: the peak follows the loudest band up
+    // immediately and decays slowly when it gets quieter. The
+    // decay is rounded up so a quiet peak still falls to 0.
+    //
+    this->_peak = max(loudest, (uint16_t)(this->_peak - ((this->_peak + 63) >> 6)));
+
+    for (uint8_t b = 0; b < this->numberOfBands; b++)
+    {
+      this->bands[b] = this->_peak > 0 ? (uint8_t)(((uint32_t)levels[b] * 255) / this->_peak) : 0;
+    }
+
+    //
+    // A beat is energy 50% above the running average. The
+    // average is updated after the comparison.
+    //
+    this->beat = this->_averageEnergy > 0 && (this->energy * 2) > (this->_averageEnergy * 3);
+    this->_averageEnergy = this->_averageEnergy - (this->_averageEnergy >> 4) + (this->energy >> 4);
+
+    returnValue = true;
+  }
+
+  return returnValue;
+}
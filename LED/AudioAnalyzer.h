@@ -0,0 +1,100 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef AUDIO_ANALYZER_H
+#define AUDIO_ANALYZER_H
+
+#include "AudioInput.h"
+#include "Fft.h"
+
+//
+// The maximum number of frequency bands.
+//
+#define AUDIO_MAXIMUM_BANDS     16
+
+//
+// Analyzes the samples of an audio input. Each time enough samples
+// are available the spectrum is calculated and grouped into bands
+// spaced logarithmically (like an octave band equalizer). The level
+// of each band, the overall energy and beats are made available to
+// effects.
+//
+class AudioAnalyzer
+{
+  public:
+    //
+    // Initializes the analyzer:
+    //  input:          The audio input to read samples from.
+    //  size:           The size of the transform, a power of 2 (64 to 256).
+    //  numberOfBands:  The number of frequency bands (1 to 16).
+    //
+    AudioAnalyzer(AudioInput*, uint16_t, uint8_t);
+    ~AudioAnalyzer();
+
+    //
+    // Reads the samples and, when a full block is available,
+    // analyzes them. If more than one block is waiting only the
+    // newest is analyzed. Returns true if the levels changed.
+    //
+    bool update();
+
+    //
+    // The level of each band scaled, with automatic gain, to the
+    // range 0 to 255.
+    //
+    uint8_t bands[AUDIO_MAXIMUM_BANDS];
+    uint8_t numberOfBands = 0;
+
+    //
+    // The total energy of the last block.
+    //
+    uint32_t energy = 0;
+
+    //
+    // True when the energy of the last block was well above
+    // the recent average.
+    //
+    bool beat = false;
+
+  protected:
+    AudioInput* _input;
+    Fft* _fft;
+    int16_t* _real;
+    int16_t* _imaginary;
+    uint16_t* _magnitudes;
+    uint16_t _count = 0;
+
+    //
+    // The first bin of each band; the last entry is the
+    // end of the last band.
+    //
+    uint16_t _edges[AUDIO_MAXIMUM_BANDS + 1];
+
+    //
+    // The slowly decaying peak level used for automatic gain.
+    //
+    uint16_t _peak = 0;
+
+    //
+    // The average energy used for beat detection.
+    //
+    uint32_t _averageEnergy = 0;
+};
+#endif
@@ -0,0 +1,89 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "AudioInput.h"
+
+//
+// Initialize the buffer with its size and the sample rate.
+//
+AudioInput::AudioInput(uint16_t size, uint32_t sampleRate)
+{
+  this->_samples = new int16_t[size];
+  this->_mask = size - 1;
+  this->sampleRate = sampleRate;
+};
+
+//
+// Deconstructor: release the buffer.
+//
+AudioInput::~AudioInput()
+{
+  delete[] this->_samples;
+};
+
+uint16_t AudioInput::available()
+{
+  //
+  // The head is 16 bits which cannot be read atomically on an
+  // 8-bit microcontroller so interrupts are disabled while it is read.
+  //
+#ifdef ARDUINO
+  noInterrupts();
+  uint16_t head = this->_head;
+  interrupts();
+#else
+  uint16_t head = this->_head;
+#endif
+
+  return (head - this->_tail) & this->_mask;
+}
+
+uint16_t AudioInput::read(int16_t *buffer, uint16_t count)
+{
+  uint16_t returnValue = min(count, this->available());
+  uint16_t tail = this->_tail;
+
+  for (uint16_t i = 0; i < returnValue; i++)
+  {
+    buffer[i] = this->_samples[tail];
+    tail = (tail + 1) & this->_mask;
+  }
+
+#ifdef ARDUINO
+  noInterrupts();
+  this->_tail = tail;
+  interrupts();
+#else
+  this->_tail = tail;
+#endif
+
+  return returnValue;
+}
+
+void AudioInput::clear()
+{
+#ifdef ARDUINO
+  noInterrupts();
+  this->_tail = this->_head;
+  interrupts();
+#else
+  this->_tail = this->_head;
+#endif
+}
@@ -0,0 +1,95 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef AUDIO_INPUT_H
+#define AUDIO_INPUT_H
+
+#include <FastLED.h>
+
+//
+// A ring buffer of audio samples. Samples are added by push(),
+// typically from the ADC conversion complete interrupt, and read
+// from loop(). There must be only one writer and one reader.
+//
+class AudioInput
+{
+  public:
+    //
+    // Initializes the buffer:
+    //  size:           The number of samples the buffer can hold. This
+    //                  must be a power of 2.
+    //  sampleRate:     The number of samples per second.
+    //
+    AudioInput(uint16_t, uint32_t);
+    ~AudioInput();
+
+    //
+    // Adds a sample. When the buffer is full the sample is
+    // dropped. This is safe to call from an interrupt.
+    //
+    inline void push(int16_t sample)
+    {
+      uint16_t head = this->_head;
+      uint16_t next = (head + 1) & this->_mask;
+
+      if (next != this->_tail)
+      {
+        this->_samples[head] = sample;
+        this->_head = next;
+      }
+      else
+      {
+        this->dropped++;
+      }
+    }
+
+    //
+    // Returns the number of samples waiting to be read.
+    //
+    uint16_t available();
+
+    //
+    // Reads up to count samples into buffer. Returns the
+    // number of samples read.
+    //
+    uint16_t read(int16_t* buffer, uint16_t count);
+
+    //
+    // Discards all of the samples in the buffer.
+    //
+    void clear();
+
+    //
+    // The number of samples per second.
+    //
+    uint32_t sampleRate = 0;
+
+    //
+    // The number of samples dropped because the buffer was full.
+    //
+    volatile uint32_t dropped = 0;
+
+  protected:
+    int16_t* _samples;
+    uint16_t _mask = 0;
+    volatile uint16_t _head = 0;
+    volatile uint16_t _tail = 0;
+};
+#endif
@@ -46,7 +46,7 @@ CRGB CHSL::toRgb()
   return CHSL::toRgb(this->h, this->s, this->l);
 }
 
-CRGB CHSL::toRgb(uint16_t h, double s, double l)
+void CHSL::channels(uint16_t h, double s, double l, double* r, double* g, double* b)
 {
   double hd = (double)(h % 360);
 
@@ -93,11 +93,25 @@ CRGB CHSL::toRgb(uint16_t h, double s, double l)
     b1 = x;
   }
 
-  byte r = (byte)(255 * (r1 + m));
-  byte g = (byte)(255 * (g1 + m));
-  byte b = (byte)(255 * (b1 + m));
+  *r = r1 + m;
+  *g = g1 + m;
+  *b = b1 + m;
+}
+
+CRGB CHSL::toRgb(uint16_t h, double s, double l)
+{
+  double r, g, b;
+  CHSL::channels(h, s, l, &r, &g, &b);
 
-  return CRGB(r, g, b);
+  return CRGB((byte)(255 * r), (byte)(255 * g), (byte)(255 * b));
+}
+
+CRGB16 CHSL::toRgb16(uint16_t h, double s, double l)
+{
+  double r, g, b;
+  CHSL::channels(h, s, l, &r, &g, &b);
+
+  return CRGB16((uint16_t)((65535 * r) + 0.5), (uint16_t)((65535 * g) + 0.5), (uint16_t)((65535 * b) + 0.5));
 }
 
 CRGB CHSL::toRgb(CHSL hsl)
@@ -105,6 +119,16 @@ CRGB CHSL::toRgb(CHSL hsl)
   return CHSL::toRgb(hsl.h, hsl.s, hsl.l);
 }
 
+CRGB16 CHSL::toRgb16()
+{
+  return CHSL::toRgb16(this->h, this->s, this->l);
+}
+
+CRGB16 CHSL::toRgb16(CHSL hsl)
+{
+  return CHSL::toRgb16(hsl.h, hsl.s, hsl.l);
+}
+
 CHSL CHSL::fromRgb(byte r, byte g, byte b)
 {
   const double toDouble = 1.0 / 255.0;
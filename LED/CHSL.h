@@ -22,6 +22,7 @@
 #define CHSL_H
 
 #include "Math.h"
+#include "CRGB16.h"
 #include <FastLED.h>
 
 class CHSL
@@ -35,6 +36,7 @@ class CHSL
     double l = 0.5;
 
     CRGB toRgb();
+    CRGB16 toRgb16();
     void incrementHue();
 
     static CHSL fromRgb(byte, byte, byte);
@@ -43,7 +45,15 @@ class CHSL
 
     static CRGB toRgb(uint16_t, double, double);
     static CRGB toRgb(CHSL);
+    static CRGB16 toRgb16(uint16_t, double, double);
+    static CRGB16 toRgb16(CHSL);
     static CRGB rgbSpectrum(uint32_t);
+
+  protected:
+    //
+    // Calculates each channel in the range 0 to 1.
+    //
+    static void channels(uint16_t, double, double, double*, double*, double*);
 };
 
 #endif
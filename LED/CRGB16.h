@@ -0,0 +1,54 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CRGB16_H
+#define CRGB16_H
+
+#include <FastLED.h>
+
+//
+// A color with 16 bits per channel. Dim colors keep their
+// precision and are reduced to CRGB with dithering by
+// HdrBuffer.
+//
+struct CRGB16
+{
+  uint16_t r;
+  uint16_t g;
+  uint16_t b;
+
+  inline CRGB16() : r(0), g(0), b(0)
+  {
+  }
+
+  inline CRGB16(uint16_t r, uint16_t g, uint16_t b) : r(r), g(g), b(b)
+  {
+  }
+
+  //
+  // Expands an 8-bit color so that 255 becomes 65535.
+  //
+  inline CRGB16(const CRGB& rgb) : r(rgb.r * 257), g(rgb.g * 257), b(rgb.b * 257)
+  {
+  }
+};
+
+static_assert(sizeof(CRGB16) == 6, "CRGB16 must be three packed channels.");
+#endif
@@ -0,0 +1,64 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Clock.h"
+
+#ifndef ARDUINO
+#include <mutex>
+
+//
+// The render engine's threads all read the time.
+//
+static std::mutex _localMutex;
+#endif
+
+IClock* Clock::_clock = NULL;
+uint32_t Clock::_last = 0;
+uint32_t Clock::_wraps = 0;
+
+uint64_t Clock::now()
+{
+  return Clock::_clock != NULL ? Clock::_clock->now() : Clock::local();
+}
+
+void Clock::use(IClock *clock)
+{
+  Clock::_clock = clock;
+}
+
+uint64_t Clock::local()
+{
+#ifndef ARDUINO
+  std::lock_guard<std::mutex> lock(_localMutex);
+#endif
+  uint32_t now = millis();
+
+  //
+  // millis() has wrapped around to 0.
+  //
+  if (now < Clock::_last)
+  {
+    Clock::_wraps++;
+  }
+
+  Clock::_last = now;
+
+  return ((uint64_t)Clock::_wraps << 32) | now;
+}
@@ -0,0 +1,87 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <FastLED.h>
+
+//
+// Defines the interface for a source of time in ms.
+//
+class IClock
+{
+  public:
+    virtual ~IClock() {}
+    virtual uint64_t now() = 0;
+};
+
+//
+// A clock that only moves when it is told to; used to run
+// effects frame by frame, for example by GoldenHarness.
+//
+class ManualClock : public IClock
+{
+  public:
+    uint64_t now()
+    {
+      return this->time;
+    }
+
+    void advance(uint64_t length)
+    {
+      this->time += length;
+    }
+
+    uint64_t time = 0;
+};
+
+//
+// The time used by the effects. By default this is millis()
+// extended to 64 bits so it does not wrap after 49 days. A
+// different clock, such as a SyncClock shared by several
+// controllers, can be used instead.
+//
+class Clock
+{
+  public:
+    //
+    // Returns the current time in ms.
+    //
+    static uint64_t now();
+
+    //
+    // Uses the specified clock; NULL returns to millis().
+    //
+    static void use(IClock* clock);
+
+    //
+    // Returns millis() extended to 64 bits. This must be called
+    // at least once every 49 days to detect the wrap around. It
+    // is safe to call from several threads on a host build.
+    //
+    static uint64_t local();
+
+  private:
+    static IClock* _clock;
+    static uint32_t _last;
+    static uint32_t _wraps;
+};
+#endif
@@ -19,6 +19,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "IEffect.h"
+#include "CHSL.h"
 
 //
 // This animation effect will create a stripe of specified length
@@ -40,6 +41,27 @@ class ColorWheelStripeEffect : public IEffect
       this->_length = length;
     }
 
+    //
+    // Supports changing the length of the stripe in addition
+    // to the parameters supported by the base. Call reset()
+    // after changing the length.
+    //
+    bool setParameter(uint8_t parameter, uint32_t value)
+    {
+      bool returnValue = true;
+
+      if (parameter == PARAMETER_LENGTH)
+      {
+        this->_length = value;
+      }
+      else
+      {
+        returnValue = IEffect::setParameter(parameter, value);
+      }
+
+      return returnValue;
+    }
+
     //
     // Resets this animation effect by setting the
     // starting LED back to 0 and then calls the base
@@ -60,6 +82,62 @@ class ColorWheelStripeEffect : public IEffect
       return IEffect::reset();
     }
 
+    //
+    // Clears the stripe and moves it to where it is at the
+    // specified frame: the stripe moves on every fifth frame,
+    // starting with the first.
+    //
+    void seekFrame(uint64_t frame)
+    {
+      for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+      {
+        this->setLed(i, CRGB::Black);
+      }
+
+      this->_currentStart = ((frame + 4) / 5) % (this->_numberOfLeds + this->_length - 1);
+      this->_currentEnd = this->_currentStart - this->_length + 1;
+      this->_frame = frame % 1530;
+    }
+
+    //
+    // Saves the length, position and color of the stripe
+    // after the base state.
+    //
+    uint8_t saveState(uint8_t *state)
+    {
+      uint8_t length = IEffect::saveState(state);
+      uint16_t stripeLength = (uint16_t)this->_length;
+      int32_t currentStart = (int32_t)this->_currentStart;
+
+      memcpy(&state[length], &stripeLength, sizeof(stripeLength));
+      memcpy(&state[length + 2], &currentStart, sizeof(currentStart));
+      memcpy(&state[length + 6], &this->_frame, sizeof(this->_frame));
+
+      return length + 8;
+    }
+
+    bool restoreState(const uint8_t *state, uint8_t length)
+    {
+      bool returnValue = false;
+
+      if (length >= EFFECT_BASE_STATE_LENGTH + 8 && IEffect::restoreState(state, length))
+      {
+        uint16_t stripeLength;
+        int32_t currentStart;
+
+        memcpy(&stripeLength, &state[EFFECT_BASE_STATE_LENGTH], sizeof(stripeLength));
+        memcpy(&currentStart, &state[EFFECT_BASE_STATE_LENGTH + 2], sizeof(currentStart));
+        memcpy(&this->_frame, &state[EFFECT_BASE_STATE_LENGTH + 6], sizeof(this->_frame));
+
+        this->_length = stripeLength;
+        this->_currentStart = currentStart;
+        this->_currentEnd = this->_currentStart - this->_length + 1;
+        returnValue = true;
+      }
+
+      return returnValue;
+    }
+
   protected:
     bool onAnimate()
     {
@@ -0,0 +1,295 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "ControlClient.h"
+
+#ifndef ARDUINO
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+//
+// The number of LEDs that fit in a single CONTROL_FRAME command
+// (command, first LED and CRC take 5 bytes).
+//
+#define CONTROL_CLIENT_LEDS_PER_FRAME   ((CONTROL_MAXIMUM_FRAME - 5) / 3)
+
+ControlClient::ControlClient()
+{
+};
+
+//
+// Deconstructor: close the device.
+//
+ControlClient::~ControlClient()
+{
+  this->close();
+};
+
+bool ControlClient::open(const char *path, uint32_t baud)
+{
+  this->close();
+  this->_fd = ::open(path, O_RDWR | O_NOCTTY);
+
+  if (this->_fd < 0)
+  {
+    return false;
+  }
+
+  //
+  // Raw mode: no echo, no line editing and no translation
+  // of the bytes.
+  //
+  struct termios options;
+
+  if (tcgetattr(this->_fd, &options) == 0)
+  {
+    cfmakeraw(&options);
+
+    speed_t speed = B115200;
+
+    switch (baud)
+    {
+      case 9600: speed = B9600; break;
+      case 57600: speed = B57600; break;
+      case 230400: speed = B230400; break;
+      case 460800: speed = B460800; break;
+      case 921600: speed = B921600; break;
+    }
+
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    tcsetattr(this->_fd, TCSANOW, &options);
+  }
+
+  this->bytesWritten = 0;
+  return true;
+}
+
+void ControlClient::close()
+{
+  if (this->_fd >= 0)
+  {
+    ::close(this->_fd);
+    this->_fd = -1;
+  }
+}
+
+bool ControlClient::send(uint8_t command, const uint8_t *payload, uint16_t length)
+{
+  uint8_t buffer[CONTROL_MAXIMUM_ENCODED];
+  uint16_t encoded = ControlPort::encode(command, payload, length, buffer);
+
+  if (this->_fd < 0 || encoded == 0)
+  {
+    return false;
+  }
+
+  uint16_t written = 0;
+
+  while (written < encoded)
+  {
+    ssize_t result = ::write(this->_fd, &buffer[written], encoded - written);
+
+    if (result <= 0)
+    {
+      return false;
+    }
+
+    written += result;
+  }
+
+  this->bytesWritten += written;
+  return true;
+}
+
+bool ControlClient::selectEffect(uint8_t effect)
+{
+  return this->send(CONTROL_SELECT_EFFECT, &effect, 1);
+}
+
+bool ControlClient::setParameter(uint8_t parameter, uint32_t value)
+{
+  uint8_t payload[5] = { parameter, (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+  return this->send(CONTROL_SET_PARAMETER, payload, sizeof(payload));
+}
+
+bool ControlClient::sendFrame(uint16_t first, const CRGB *leds, uint16_t count, bool show)
+{
+  uint8_t payload[CONTROL_MAXIMUM_FRAME];
+
+  for (uint16_t i = 0; i < count; i += CONTROL_CLIENT_LEDS_PER_FRAME)
+  {
+    uint16_t index = first + i;
+    uint16_t n = count - i < CONTROL_CLIENT_LEDS_PER_FRAME ? count - i : CONTROL_CLIENT_LEDS_PER_FRAME;
+
+    payload[0] = (uint8_t)index;
+    payload[1] = (uint8_t)(index >> 8);
+
+    for (uint16_t j = 0; j < n; j++)
+    {
+      payload[2 + (j * 3)] = leds[i + j].r;
+      payload[3 + (j * 3)] = leds[i + j].g;
+      payload[4 + (j * 3)] = leds[i + j].b;
+    }
+
+    if (!this->send(CONTROL_FRAME, payload, 2 + (n * 3)))
+    {
+      return false;
+    }
+  }
+
+  return show ? this->send(CONTROL_SHOW, NULL, 0) : true;
+}
+
+bool ControlClient::ping(uint32_t timeout)
+{
+  if (!this->send(CONTROL_PING, NULL, 0))
+  {
+    return false;
+  }
+
+  //
+  // Wait for the encoded CONTROL_PONG reply. Anything else the
+  // sketch writes (such as debug text) is skipped; a frame is
+  // everything between two 0 bytes.
+  //
+  uint8_t expected[8];
+  uint16_t length = ControlPort::encode(CONTROL_PONG, NULL, 0, expected);
+  uint16_t matched = 0;
+  struct pollfd descriptor = { this->_fd, POLLIN, 0 };
+
+  while (::poll(&descriptor, 1, timeout) > 0)
+  {
+    uint8_t b;
+
+    if (::read(this->_fd, &b, 1) != 1)
+    {
+      break;
+    }
+
+    if (b == expected[matched])
+    {
+      matched++;
+
+      if (matched == length)
+      {
+        return true;
+      }
+    }
+    else
+    {
+      matched = (b == expected[0]) ? 1 : 0;
+    }
+  }
+
+  return false;
+}
+
+uint16_t ControlClient::receive(uint8_t *frame, uint32_t timeout)
+{
+  uint8_t encoded[CONTROL_MAXIMUM_ENCODED];
+  uint16_t length = 0;
+  struct pollfd descriptor = { this->_fd, POLLIN, 0 };
+
+  while (this->_fd >= 0 && ::poll(&descriptor, 1, timeout) > 0)
+  {
+    uint8_t b;
+
+    if (::read(this->_fd, &b, 1) != 1)
+    {
+      break;
+    }
+
+    if (b != 0)
+    {
+      //
+      // Text written by the sketch ends at the 0 sent before each
+      // frame (see ControlPort::send()) and does not decode. Text
+      // longer than any frame is cut short here.
+      //
+      if (length < sizeof(encoded))
+      {
+        encoded[length++] = b;
+      }
+    }
+    else
+    {
+      uint16_t decoded = length <= CONTROL_MAXIMUM_ENCODED ? ControlPort::decode(encoded, length, frame) : 0;
+
+      if (decoded > 0)
+      {
+        return decoded;
+      }
+
+      length = 0;
+    }
+  }
+
+  return 0;
+}
+
+int32_t ControlClient::trace(uint8_t *buffer, uint32_t size, uint32_t timeout)
+{
+  uint8_t frame[CONTROL_MAXIMUM_ENCODED];
+  uint32_t length = 0;
+
+  if (!this->send(CONTROL_TRACE, NULL, 0))
+  {
+    return -1;
+  }
+
+  //
+  // The dump arrives in numbered pieces (see ControlWriter); one
+  // with no data ends it. A piece that is out of sequence means
+  // one was lost, and the dump is not returned without it.
+  //
+  uint16_t decoded;
+  uint8_t sequence = 0;
+
+  while ((decoded = this->receive(frame, timeout)) > 0)
+  {
+    if (frame[0] == CONTROL_TRACE)
+    {
+      if (decoded < 2 || frame[1] != sequence++)
+      {
+        return -1;
+      }
+
+      if (decoded == 2)
+      {
+        return (int32_t)length;
+      }
+
+      if (length + decoded - 2 > size)
+      {
+        return -1;
+      }
+
+      memcpy(&buffer[length], &frame[2], decoded - 2);
+      length += decoded - 2;
+    }
+  }
+
+  return -1;
+}
+#endif
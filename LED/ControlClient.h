@@ -0,0 +1,92 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CONTROL_CLIENT_H
+#define CONTROL_CLIENT_H
+
+//
+// The control client runs on the host (Linux, macOS) and
+// talks to the ControlPort in the sketch.
+//
+#ifndef ARDUINO
+#include "ControlPort.h"
+
+//
+// Sends commands to a ControlPort over a serial device
+// (for example /dev/ttyACM0) or a pseudo-terminal.
+//
+class ControlClient
+{
+  public:
+    ControlClient();
+    ~ControlClient();
+
+    //
+    // Opens the device in raw mode at the specified baud rate
+    // (ignored by pseudo-terminals). Returns false on failure.
+    //
+    bool open(const char* path, uint32_t baud);
+    void close();
+
+    bool selectEffect(uint8_t effect);
+    bool setParameter(uint8_t parameter, uint32_t value);
+
+    //
+    // Sends LEDs starting at first, split across as many
+    // commands as needed, and optionally displays them.
+    //
+    bool sendFrame(uint16_t first, const CRGB* leds, uint16_t count, bool show);
+
+    //
+    // Sends a ping and waits up to timeout ms for the reply.
+    //
+    bool ping(uint32_t timeout);
+
+    //
+    // Requests the trace dump (see Trace.h) and copies it into
+    // buffer. Returns the length of the dump, or -1 if it did not
+    // arrive within timeout ms of the last reply, a reply was lost
+    // or it did not fit.
+    //
+    int32_t trace(uint8_t* buffer, uint32_t size, uint32_t timeout);
+
+    //
+    // Waits up to timeout ms for a command from the sketch and
+    // decodes it into frame, which must hold CONTROL_MAXIMUM_ENCODED
+    // bytes. Anything that is not a valid frame is skipped. Returns
+    // the length of the command and payload, or 0 on a timeout.
+    //
+    uint16_t receive(uint8_t* frame, uint32_t timeout);
+
+    //
+    // Sends a command.
+    //
+    bool send(uint8_t command, const uint8_t* payload, uint16_t length);
+
+    //
+    // The number of bytes written since the device was opened.
+    //
+    uint64_t bytesWritten = 0;
+
+  protected:
+    int _fd = -1;
+};
+#endif
+#endif
@@ -0,0 +1,291 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "ControlPort.h"
+
+//
+// Initialize the port with a stream and the size
+// of the largest frame.
+//
+ControlPort::ControlPort(Stream *stream, uint16_t size)
+{
+  this->_stream = stream;
+  this->_size = size;
+  this->_buffer = new uint8_t[size];
+};
+
+//
+// Deconstructor: release the buffer.
+//
+ControlPort::~ControlPort()
+{
+  delete[] this->_buffer;
+  this->_stream = NULL;
+};
+
+void ControlPort::setCommandHandler(void (*handler)(uint8_t, const uint8_t*, uint16_t))
+{
+  this->_handler = handler;
+}
+
+uint8_t ControlPort::poll(uint16_t maximumBytes)
+{
+  uint8_t returnValue = 0;
+
+  while (maximumBytes > 0 && this->_stream->available() > 0)
+  {
+    maximumBytes--;
+    uint8_t b = (uint8_t)this->_stream->read();
+
+    if (b == 0)
+    {
+      //
+      // The end of a frame. It is only complete if the
+      // last block has been fully received.
+      //
+      if (this->_length > 0 || this->_remaining > 0)
+      {
+        if (this->_remaining == 0 && !this->_overflow && this->dispatch())
+        {
+          returnValue++;
+        }
+        else
+        {
+          this->errors++;
+        }
+      }
+
+      this->_length = 0;
+      this->_code = 0;
+      this->_remaining = 0;
+      this->_overflow = false;
+    }
+    else if (this->_remaining == 0)
+    {
+      //
+      // The start of a block. Every block except the first, and
+      // those that follow a full (0xFF) block, replaces a 0.
+      //
+      if (this->_code != 0 && this->_code != 0xFF)
+      {
+        if (this->_length < this->_size)
+        {
+          this->_buffer[this->_length++] = 0;
+        }
+        else
+        {
+          this->_overflow = true;
+        }
+      }
+
+      this->_code = b;
+      this->_remaining = b - 1;
+    }
+    else
+    {
+      if (this->_length < this->_size)
+      {
+        this->_buffer[this->_length++] = b;
+      }
+      else
+      {
+        this->_overflow = true;
+      }
+
+      this->_remaining--;
+    }
+  }
+
+  return returnValue;
+}
+
+bool ControlPort::dispatch()
+{
+  bool returnValue = false;
+
+  //
+  // A frame is at least a command and the CRC.
+  //
+  if (this->_length >= 3)
+  {
+    uint16_t length = this->_length - 2;
+    uint16_t received = (uint16_t)this->_buffer[length] | ((uint16_t)this->_buffer[length + 1] << 8);
+
+    if (ControlPort::crc(this->_buffer, length) == received)
+    {
+      this->commands++;
+
+      if (this->_buffer[0] == CONTROL_PING)
+      {
+        this->send(CONTROL_PONG, NULL, 0);
+      }
+
+      if (this->_handler != NULL)
+      {
+        this->_handler(this->_buffer[0], &this->_buffer[1], length - 1);
+      }
+
+      returnValue = true;
+    }
+  }
+
+  return returnValue;
+}
+
+bool ControlPort::send(uint8_t command, const uint8_t *payload, uint16_t length)
+{
+  bool returnValue = false;
+
+  //
+  // Replies are short so they are encoded on the stack. A 0 is
+  // sent first so anything printed to the port before the reply
+  // (such as debug text) ends there instead of running into it.
+  //
+  if (length <= CONTROL_MAXIMUM_REPLY)
+  {
+    uint8_t buffer[CONTROL_MAXIMUM_REPLY + 7];
+    buffer[0] = 0;
+
+    uint16_t encoded = ControlPort::encode(command, payload, length, &buffer[1]) + 1;
+    returnValue = this->_stream->write(buffer, encoded) == encoded;
+  }
+
+  return returnValue;
+}
+
+uint16_t ControlPort::encode(uint8_t command, const uint8_t *payload, uint16_t length, uint8_t *buffer)
+{
+  uint16_t total = length + 3;
+
+  if (total > CONTROL_MAXIMUM_FRAME)
+  {
+    return 0;
+  }
+
+  uint16_t crc = ControlPort::crc(&command, 1);
+  crc = ControlPort::crc(payload, length, crc);
+
+  //
+  // code is the position of the code byte of the current
+  // block; it is filled in when the block ends.
+  //
+  uint16_t code = 0;
+  uint16_t position = 1;
+  uint8_t count = 1;
+
+  for (uint16_t i = 0; i < total; i++)
+  {
+    uint8_t b;
+
+    if (i == 0)
+    {
+      b = command;
+    }
+    else if (i <= length)
+    {
+      b = payload[i - 1];
+    }
+    else
+    {
+      b = i == length + 1 ? (uint8_t)crc : (uint8_t)(crc >> 8);
+    }
+
+    if (b == 0)
+    {
+      buffer[code] = count;
+      code = position++;
+      count = 1;
+    }
+    else
+    {
+      buffer[position++] = b;
+      count++;
+
+      if (count == 0xFF)
+      {
+        buffer[code] = count;
+        code = position++;
+        count = 1;
+      }
+    }
+  }
+
+  buffer[code] = count;
+  buffer[position++] = 0;
+
+  return position;
+}
+
+uint16_t ControlPort::decode(const uint8_t *encoded, uint16_t length, uint8_t *buffer)
+{
+  uint16_t decoded = 0;
+  uint16_t i = 0;
+
+  while (i < length)
+  {
+    uint8_t code = encoded[i++];
+
+    if (code == 0 || i + code - 1 > length)
+    {
+      return 0;
+    }
+
+    for (uint8_t j = 1; j < code; j++)
+    {
+      buffer[decoded++] = encoded[i++];
+    }
+
+    //
+    // Every block except the last, and those that are full
+    // (0xFF), ends with a 0 that was removed.
+    //
+    if (code != 0xFF && i < length)
+    {
+      buffer[decoded++] = 0;
+    }
+  }
+
+  //
+  // A frame is at least a command and the CRC.
+  //
+  if (decoded < 3)
+  {
+    return 0;
+  }
+
+  decoded -= 2;
+
+  return ControlPort::crc(buffer, decoded) == ((uint16_t)buffer[decoded] | ((uint16_t)buffer[decoded + 1] << 8)) ? decoded : 0;
+}
+
+uint16_t ControlPort::crc(const uint8_t *data, uint16_t length, uint16_t crc)
+{
+  for (uint16_t i = 0; i < length; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+
+    for (uint8_t b = 0; b < 8; b++)
+    {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+
+  return crc;
+}
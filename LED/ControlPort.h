@@ -0,0 +1,205 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CONTROL_PORT_H
+#define CONTROL_PORT_H
+
+#include <FastLED.h>
+
+//
+// Commands of the control protocol. The payload of each
+// command follows the command byte (multi-byte values are
+// little endian).
+//
+#define CONTROL_SELECT_EFFECT     0x01    // effect (uint8)
+#define CONTROL_SET_PARAMETER     0x02    // parameter (uint8), value (uint32)
+#define CONTROL_FRAME             0x03    // first LED (uint16), r, g, b, r, g, b, ...
+#define CONTROL_SHOW              0x04    // (none) displays the frame
+#define CONTROL_PING              0x05    // (none) answered with CONTROL_PONG
+#define CONTROL_PONG              0x06    // (none)
+#define CONTROL_TRACE             0x07    // (none) answered with the trace dump in
+                                          // CONTROL_TRACE replies (see ControlWriter)
+
+//
+// The largest frame before encoding (command + payload + CRC)
+// that encode() will produce.
+//
+#define CONTROL_MAXIMUM_FRAME     256
+
+//
+// The size of a buffer large enough to hold an encoded frame
+// of CONTROL_MAXIMUM_FRAME bytes (COBS overhead plus the
+// delimiter).
+//
+#define CONTROL_MAXIMUM_ENCODED   (CONTROL_MAXIMUM_FRAME + (CONTROL_MAXIMUM_FRAME / 254) + 2)
+
+//
+// The largest payload that send() will send.
+//
+#define CONTROL_MAXIMUM_REPLY     16
+
+//
+// Receives commands over a serial port (or any Stream) using a
+// compact binary protocol. Each frame is a command byte, its payload
+// and a CRC-16 (CCITT), encoded with COBS (Consistent Overhead Byte
+// Stuffing) so that a 0 byte only ever marks the end of a frame.
+//
+// The bytes are decoded as they arrive and poll() reads at most a
+// specified number of bytes so calling it from loop() does not
+// affect the timing of the animation.
+//
+class ControlPort
+{
+  public:
+    //
+    // Initializes the port:
+    //  stream:         The stream to read from (for example &Serial).
+    //  size:           The size of the largest frame that can be received.
+    //
+    ControlPort(Stream*, uint16_t);
+    ~ControlPort();
+
+    //
+    // Sets the method called with each valid command received.
+    //
+    void setCommandHandler(void (*handler)(uint8_t command, const uint8_t* payload, uint16_t length));
+
+    //
+    // Reads and decodes up to maximumBytes bytes. Returns
+    // the number of commands received.
+    //
+    uint8_t poll(uint16_t maximumBytes);
+
+    //
+    // Sends a command with a payload of up to
+    // CONTROL_MAXIMUM_REPLY bytes. The frame is preceded by a 0
+    // so it is not lost if text was printed to the port first.
+    //
+    bool send(uint8_t command, const uint8_t* payload, uint16_t length);
+
+    //
+    // Encodes a command into buffer, which must hold at least
+    // CONTROL_MAXIMUM_ENCODED bytes, including the trailing 0.
+    // Returns the encoded length or 0 if the payload is too long.
+    //
+    static uint16_t encode(uint8_t command, const uint8_t* payload, uint16_t length, uint8_t* buffer);
+
+    //
+    // Decodes an encoded frame (without the trailing 0) into buffer,
+    // which must hold at least length bytes. Returns the length of
+    // the command and payload, or 0 if the frame is not valid.
+    //
+    static uint16_t decode(const uint8_t* encoded, uint16_t length, uint8_t* buffer);
+
+    //
+    // Calculates the CRC-16 (CCITT) of data.
+    //
+    static uint16_t crc(const uint8_t* data, uint16_t length, uint16_t crc = 0xFFFF);
+
+    //
+    // Statistics.
+    //
+    uint32_t commands = 0;
+    uint32_t errors = 0;
+
+  protected:
+    //
+    // Validates and dispatches a decoded frame.
+    //
+    bool dispatch();
+
+    Stream* _stream;
+    void (*_handler)(uint8_t, const uint8_t*, uint16_t) = NULL;
+
+    //
+    // The decoded frame.
+    //
+    uint8_t* _buffer;
+    uint16_t _size = 0;
+    uint16_t _length = 0;
+
+    //
+    // The state of the COBS decoder: the code of the current
+    // block and the number of bytes left in it.
+    //
+    uint8_t _code = 0;
+    uint8_t _remaining = 0;
+    bool _overflow = false;
+};
+
+//
+// Sends everything printed to it as the payload of a series of
+// commands so binary data (such as a trace dump) can share the port
+// with the protocol. Each payload is a sequence number (uint8,
+// starting at 0) followed by up to CONTROL_MAXIMUM_REPLY - 1 bytes,
+// so the receiver can tell if a command was lost. end() sends what
+// is left followed by a command with only the sequence number.
+//
+class ControlWriter : public Print
+{
+  public:
+    ControlWriter(ControlPort* port, uint8_t command)
+    {
+      this->_port = port;
+      this->_command = command;
+    }
+
+    size_t write(uint8_t value)
+    {
+      this->_buffer[this->_length++] = value;
+
+      if (this->_length == CONTROL_MAXIMUM_REPLY)
+      {
+        this->flush();
+      }
+
+      return 1;
+    }
+
+    using Print::write;
+
+    void end()
+    {
+      if (this->_length > 1)
+      {
+        this->flush();
+      }
+
+      this->flush();
+    }
+
+  protected:
+    //
+    // Sends the buffer and starts the next command.
+    //
+    void flush()
+    {
+      this->_buffer[0] = this->_sequence++;
+      this->_port->send(this->_command, this->_buffer, this->_length);
+      this->_length = 1;
+    }
+
+    ControlPort* _port;
+    uint8_t _command;
+    uint8_t _buffer[CONTROL_MAXIMUM_REPLY];
+    uint8_t _length = 1;
+    uint8_t _sequence = 0;
+};
+#endif
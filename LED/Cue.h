@@ -0,0 +1,71 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CUE_H
+#define CUE_H
+
+//
+// Defines the compiled format of a cue list (a show). A show is
+// stored in flash as a header followed by fixed length cue records
+// so any cue can be found with a single multiplication.
+//
+//  Header (5 bytes):
+//    'C', 'Q', version, number of cues (uint16)
+//
+//  Cue (22 bytes, little endian):
+//    start             uint32    The time, in ms, the cue starts from the start of the show.
+//    duration          uint32    The length of the cue in ms.
+//    effect            uint8     The index of the effect.
+//    transition        uint8     CUE_CUT or CUE_FADE.
+//    transitionLength  uint16    The length of the transition in ms.
+//    parameter1        uint8     The first parameter (PARAMETER_*) or CUE_NONE.
+//    parameter2        uint8     The second parameter (PARAMETER_*) or CUE_NONE.
+//    value1            uint32    The value of the first parameter.
+//    value2            uint32    The value of the second parameter.
+//
+// A show can be written directly with the macros below or produced
+// from a text cue list on the host by CueCompiler.
+//
+#define CUE_MAGIC_1         'C'
+#define CUE_MAGIC_2         'Q'
+#define CUE_VERSION         1
+#define CUE_HEADER_LENGTH   5
+#define CUE_LENGTH          22
+
+//
+// Transitions.
+//
+#define CUE_CUT             0
+#define CUE_FADE            1
+
+//
+// Indicates a parameter slot is not used.
+//
+#define CUE_NONE            0xFF
+
+#define CUE_UINT16(v)       (uint8_t)((v) & 0xFF), (uint8_t)(((v) >> 8) & 0xFF)
+#define CUE_UINT32(v)       (uint8_t)((v) & 0xFF), (uint8_t)(((v) >> 8) & 0xFF), (uint8_t)(((v) >> 16) & 0xFF), (uint8_t)(((v) >> 24) & 0xFF)
+
+#define CUE_HEADER(count)   CUE_MAGIC_1, CUE_MAGIC_2, CUE_VERSION, CUE_UINT16(count)
+
+#define CUE(start, duration, effect, transition, transitionLength, parameter1, value1, parameter2, value2) \
+  CUE_UINT32(start), CUE_UINT32(duration), (uint8_t)(effect), (uint8_t)(transition), CUE_UINT16(transitionLength), \
+  (uint8_t)(parameter1), (uint8_t)(parameter2), CUE_UINT32(value1), CUE_UINT32(value2)
+#endif
@@ -0,0 +1,186 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "CueCompiler.h"
+
+#ifndef ARDUINO
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "IEffect.h"
+#include "Cue.h"
+
+bool CueCompiler::compile(FILE *input, FILE *output, const char *name)
+{
+  struct Cue
+  {
+    uint32_t start;
+    uint32_t duration;
+    uint8_t effect;
+    uint8_t transition;
+    uint16_t transitionLength;
+    uint8_t parameters[2];
+    uint32_t values[2];
+  };
+
+  std::vector<Cue> cues;
+  char text[256];
+
+  this->error = NULL;
+  this->line = 0;
+  this->length = 0;
+
+  while (fgets(text, sizeof(text), input) != NULL)
+  {
+    this->line++;
+
+    char* token = strtok(text, " \t\r\n");
+
+    if (token == NULL || token[0] == '#')
+    {
+      continue;
+    }
+
+    Cue cue = { this->length, 0, 0, CUE_CUT, 0, { CUE_NONE, CUE_NONE }, { 0, 0 } };
+    uint8_t numberOfParameters = 0;
+    char* end;
+
+    cue.effect = (uint8_t)strtoul(token, &end, 10);
+
+    token = strtok(NULL, " \t\r\n");
+
+    if (*end != '\0' || token == NULL)
+    {
+      this->error = "expected an effect and a duration";
+      return false;
+    }
+
+    cue.duration = strtoul(token, &end, 10);
+
+    if (*end != '\0' || cue.duration == 0)
+    {
+      this->error = "the duration must be a number greater than 0";
+      return false;
+    }
+
+    while ((token = strtok(NULL, " \t\r\n")) != NULL)
+    {
+      char* value = strchr(token, '=');
+
+      if (strcmp(token, "cut") == 0)
+      {
+        cue.transition = CUE_CUT;
+      }
+      else if (strcmp(token, "fade") == 0)
+      {
+        token = strtok(NULL, " \t\r\n");
+
+        if (token == NULL)
+        {
+          this->error = "expected the length of the fade";
+          return false;
+        }
+
+        cue.transition = CUE_FADE;
+        cue.transitionLength = (uint16_t)strtoul(token, &end, 10);
+      }
+      else if (value != NULL)
+      {
+        if (numberOfParameters == 2)
+        {
+          this->error = "a cue can have at most two parameters";
+          return false;
+        }
+
+        *value++ = '\0';
+
+        if (strcmp(token, "frameLength") == 0)
+        {
+          cue.parameters[numberOfParameters] = PARAMETER_FRAME_LENGTH;
+          cue.values[numberOfParameters] = strtoul(value, &end, 10);
+        }
+        else if (strcmp(token, "color") == 0)
+        {
+          cue.parameters[numberOfParameters] = PARAMETER_COLOR;
+          cue.values[numberOfParameters] = strtoul(value, &end, 16);
+        }
+        else if (strcmp(token, "length") == 0)
+        {
+          cue.parameters[numberOfParameters] = PARAMETER_LENGTH;
+          cue.values[numberOfParameters] = strtoul(value, &end, 10);
+        }
+        else if (strcmp(token, "fade") == 0)
+        {
+          cue.parameters[numberOfParameters] = PARAMETER_FADE;
+          cue.values[numberOfParameters] = (uint32_t)((strtod(value, &end) * 1000.0) + 0.5);
+        }
+        else
+        {
+          this->error = "unknown parameter";
+          return false;
+        }
+
+        numberOfParameters++;
+      }
+      else
+      {
+        this->error = "unexpected text";
+        return false;
+      }
+
+      if (*end != '\0')
+      {
+        this->error = "invalid number";
+        return false;
+      }
+    }
+
+    cues.push_back(cue);
+    this->length += cue.duration;
+  }
+
+  if (cues.size() > 0xFFFF)
+  {
+    this->error = "too many cues";
+    return false;
+  }
+
+  this->numberOfCues = (uint16_t)cues.size();
+
+  //
+  // Write the show using the macros in Cue.h.
+  //
+  fprintf(output, "//\n// Compiled show: %u cues, %lu ms.\n//\n", this->numberOfCues, (unsigned long)this->length);
+  fprintf(output, "const uint8_t %s[] PROGMEM =\n{\n  CUE_HEADER(%u)", name, this->numberOfCues);
+
+  for (size_t i = 0; i < cues.size(); i++)
+  {
+    const Cue& cue = cues[i];
+    fprintf(output, ",\n  CUE(%lu, %lu, %u, %s, %u, %u, 0x%lX, %u, 0x%lX)",
+            (unsigned long)cue.start, (unsigned long)cue.duration, cue.effect,
+            cue.transition == CUE_FADE ? "CUE_FADE" : "CUE_CUT", cue.transitionLength,
+            cue.parameters[0], (unsigned long)cue.values[0], cue.parameters[1], (unsigned long)cue.values[1]);
+  }
+
+  fprintf(output, "\n};\n");
+
+  return true;
+}
+#endif
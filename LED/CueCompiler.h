@@ -0,0 +1,68 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CUE_COMPILER_H
+#define CUE_COMPILER_H
+
+//
+// The cue compiler runs on the host; the compiled show is
+// included in the sketch.
+//
+#ifndef ARDUINO
+#include <cstdio>
+#include <cstdint>
+
+//
+// Compiles a text cue list into a show (see Cue.h) written as a
+// header file that can be included in the sketch. Each line of the
+// cue list is a cue:
+//
+//  <effect> <duration> [cut | fade <length>] [<parameter>=<value> ...]
+//
+// where effect is the index of the effect, durations and lengths are
+// in ms and the parameters are frameLength, color (0xRRGGBB), length
+// and fade (for example 0.65). Blank lines and lines starting with #
+// are ignored.
+//
+class CueCompiler
+{
+  public:
+    //
+    // Compiles the cue list read from input and writes it to
+    // output as an array with the specified name. Returns false,
+    // with error and line set, if the cue list is not valid.
+    //
+    bool compile(FILE* input, FILE* output, const char* name);
+
+    //
+    // The error and the line it occurred on.
+    //
+    const char* error = NULL;
+    uint32_t line = 0;
+
+    //
+    // The number of cues and the total length of the
+    // show in ms.
+    //
+    uint16_t numberOfCues = 0;
+    uint32_t length = 0;
+};
+#endif
+#endif
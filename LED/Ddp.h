@@ -0,0 +1,66 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef DDP_H
+#define DDP_H
+
+//
+// Constants for the Distributed Display Protocol (DDP). See
+// http://www.3waylabs.com/ddp/ for the protocol definition.
+//
+
+//
+// The UDP port DDP devices listen on.
+//
+#define DDP_PORT                4048
+
+//
+// The length of the header; when the timecode flag is set
+// the header is followed by a 4 byte timecode.
+//
+#define DDP_HEADER_LENGTH       10
+#define DDP_TIMECODE_LENGTH     4
+
+//
+// The maximum amount of pixel data in a single packet. This
+// keeps each packet within a standard Ethernet frame and is
+// a multiple of 3 so a pixel is never split between packets.
+//
+#define DDP_MAX_DATA_LENGTH     1440
+#define DDP_PIXELS_PER_PACKET   (DDP_MAX_DATA_LENGTH / 3)
+
+//
+// Header flags (byte 0).
+//
+#define DDP_FLAG_VERSION_MASK   0xC0
+#define DDP_FLAG_VERSION_1      0x40
+#define DDP_FLAG_TIMECODE       0x10
+#define DDP_FLAG_PUSH           0x01
+
+//
+// Data type (byte 2): RGB with 8 bits per channel.
+//
+#define DDP_TYPE_RGB8           0x0B
+
+//
+// Destination (byte 3): the default output device.
+//
+#define DDP_ID_DISPLAY          0x01
+#endif
@@ -0,0 +1,106 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "DdpOutput.h"
+
+//
+// Initialize the output using the default DDP port.
+//
+DdpOutput::DdpOutput(CRGB *leds, uint32_t numberOfLeds, UDP *udp, IPAddress address) : DdpOutput(leds, numberOfLeds, udp, address, DDP_PORT)
+{
+};
+
+//
+// Initialize the output with an LED array, the number of LEDs,
+// the UDP instance and the address and port of the DDP device.
+//
+DdpOutput::DdpOutput(CRGB *leds, uint32_t numberOfLeds, UDP *udp, IPAddress address, uint16_t port) : PacketOutput(leds, numberOfLeds, DDP_PIXELS_PER_PACKET)
+{
+  this->_udp = udp;
+  this->_address = address;
+  this->_port = port;
+};
+
+bool DdpOutput::show()
+{
+  //
+  // The last changed packet carries the push flag so the device
+  // displays the frame once all of the data has arrived.
+  //
+  bool returnValue = PacketOutput::show();
+
+  //
+  // The sequence number is in the range 1 to 15; 0 means
+  // the sequence number is not used.
+  //
+  if (returnValue)
+  {
+    this->_sequence = (this->_sequence % 15) + 1;
+  }
+
+  return returnValue;
+}
+
+bool DdpOutput::sendPacket(uint32_t packet, bool push)
+{
+  uint32_t firstLed = this->firstLed(packet);
+  uint32_t numberOfLeds = this->ledsInPacket(packet);
+  uint32_t offset = firstLed * 3;
+  uint16_t length = numberOfLeds * 3;
+
+  uint8_t header[DDP_HEADER_LENGTH + DDP_TIMECODE_LENGTH];
+  header[0] = DDP_FLAG_VERSION_1 | (push ? DDP_FLAG_PUSH : 0) | (this->timecode ? DDP_FLAG_TIMECODE : 0);
+  header[1] = this->_sequence;
+  header[2] = DDP_TYPE_RGB8;
+  header[3] = DDP_ID_DISPLAY;
+  header[4] = (uint8_t)(offset >> 24);
+  header[5] = (uint8_t)(offset >> 16);
+  header[6] = (uint8_t)(offset >> 8);
+  header[7] = (uint8_t)offset;
+  header[8] = (uint8_t)(length >> 8);
+  header[9] = (uint8_t)length;
+
+  uint8_t headerLength = DDP_HEADER_LENGTH;
+
+  if (this->timecode)
+  {
+    uint32_t now = micros();
+    header[10] = (uint8_t)(now >> 24);
+    header[11] = (uint8_t)(now >> 16);
+    header[12] = (uint8_t)(now >> 8);
+    header[13] = (uint8_t)now;
+    headerLength += DDP_TIMECODE_LENGTH;
+  }
+
+  bool returnValue = false;
+
+  if (this->_udp->beginPacket(this->_address, this->_port))
+  {
+    //
+    // CRGB is stored as r, g, b which matches the DDP pixel
+    // format so the data is written directly from the LED array.
+    //
+    this->_udp->write(header, headerLength);
+    this->_udp->write((const uint8_t*)&this->_leds[firstLed], length);
+    returnValue = this->_udp->endPacket() == 1;
+  }
+
+  return returnValue;
+}
@@ -0,0 +1,73 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef DDP_OUTPUT_H
+#define DDP_OUTPUT_H
+
+#include <Udp.h>
+#include "PacketOutput.h"
+#include "Ddp.h"
+
+//
+// This output sends the LED array over UDP using the Distributed
+// Display Protocol (DDP). The array is split into packets of up to
+// 480 pixels and only the packets that have changed since the last
+// frame are sent. The pixel data is written directly from the LED
+// array without being copied into an intermediate buffer.
+//
+class DdpOutput : public PacketOutput
+{
+  public:
+    //
+    // Initializes the output:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  udp:            The UDP instance (WiFiUDP, EthernetUDP, etc.) used to send packets.
+    //  address:        The IP address of the DDP device.
+    //  port:           The UDP port of the DDP device.
+    //
+    DdpOutput(CRGB*, uint32_t, UDP*, IPAddress);
+    DdpOutput(CRGB*, uint32_t, UDP*, IPAddress, uint16_t);
+
+    //
+    // Sends each packet that has changed since the last frame
+    // setting the push flag on the last packet sent.
+    //
+    bool show();
+
+    //
+    // When enabled, the value of micros() at the time the packet
+    // is sent is included as the timecode. This is intended for
+    // measuring latency with a receiver that shares the same clock.
+    //
+    bool timecode = false;
+
+  protected:
+    //
+    // Sends a single packet.
+    //
+    bool sendPacket(uint32_t packet, bool push);
+
+    UDP* _udp;
+    IPAddress _address;
+    uint16_t _port = DDP_PORT;
+    uint8_t _sequence = 1;
+};
+#endif
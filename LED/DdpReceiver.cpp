@@ -0,0 +1,153 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "DdpReceiver.h"
+
+//
+// Initialize the receiver with an LED array, the number of
+// LEDs and the UDP instance.
+//
+DdpReceiver::DdpReceiver(CRGB *leds, uint32_t numberOfLeds, UDP *udp)
+{
+  this->_leds = leds;
+  this->_numberOfLeds = numberOfLeds;
+  this->_udp = udp;
+};
+
+//
+// Deconstructor: remove the reference to the LEDs.
+//
+DdpReceiver::~DdpReceiver()
+{
+  this->_leds = NULL;
+  this->_udp = NULL;
+};
+
+void DdpReceiver::reset()
+{
+  this->packets = 0;
+  this->frames = 0;
+  this->invalid = 0;
+  this->lost = 0;
+  this->latency = 0;
+  this->_sequence = 0;
+  this->_windowStart = millis();
+  this->_windowPackets = 0;
+  this->_packetsPerSecond = 0;
+}
+
+uint32_t DdpReceiver::packetsPerSecond()
+{
+  return this->_packetsPerSecond;
+}
+
+bool DdpReceiver::poll()
+{
+  bool returnValue = false;
+
+  //
+  // Roll the packets per second window.
+  //
+  uint32_t now = millis();
+
+  if (now - this->_windowStart >= 1000)
+  {
+    this->_packetsPerSecond = this->_windowPackets;
+    this->_windowPackets = 0;
+    this->_windowStart = now;
+  }
+
+  int size = this->_udp->parsePacket();
+
+  if (size > 0)
+  {
+    uint8_t header[DDP_HEADER_LENGTH + DDP_TIMECODE_LENGTH];
+
+    if (size < DDP_HEADER_LENGTH || this->_udp->read(header, DDP_HEADER_LENGTH) != DDP_HEADER_LENGTH)
+    {
+      this->invalid++;
+      return false;
+    }
+
+    uint8_t flags = header[0];
+    uint32_t offset = ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16) | ((uint32_t)header[6] << 8) | header[7];
+    uint16_t length = ((uint16_t)header[8] << 8) | header[9];
+    uint16_t headerLength = DDP_HEADER_LENGTH;
+
+    if ((flags & DDP_FLAG_TIMECODE) != 0)
+    {
+      if (size < DDP_HEADER_LENGTH + DDP_TIMECODE_LENGTH || this->_udp->read(&header[DDP_HEADER_LENGTH], DDP_TIMECODE_LENGTH) != DDP_TIMECODE_LENGTH)
+      {
+        this->invalid++;
+        return false;
+      }
+
+      uint32_t timecode = ((uint32_t)header[10] << 24) | ((uint32_t)header[11] << 16) | ((uint32_t)header[12] << 8) | header[13];
+      this->latency = micros() - timecode;
+      headerLength += DDP_TIMECODE_LENGTH;
+    }
+
+    //
+    // Verify the version, that the packet contains all of the
+    // data it claims to and that the data fits in the LED array.
+    //
+    if ((flags & DDP_FLAG_VERSION_MASK) != DDP_FLAG_VERSION_1 ||
+        size < headerLength + length ||
+        (uint64_t)offset + length > this->_numberOfLeds * 3)
+    {
+      this->invalid++;
+      return false;
+    }
+
+    //
+    // The sequence number advances once per frame (1 to 15, 0 is
+    // unused) so a gap indicates a frame was missed.
+    //
+    uint8_t sequence = header[1] & 0x0F;
+
+    if (sequence != 0 && this->_sequence != 0)
+    {
+      uint8_t expected = (this->_sequence % 15) + 1;
+
+      if (sequence != this->_sequence && sequence != expected)
+      {
+        this->lost += (sequence + 15 - expected) % 15;
+      }
+    }
+
+    this->_sequence = sequence;
+
+    //
+    // Read the pixel data directly into the LED array.
+    //
+    this->_udp->read((uint8_t*)this->_leds + offset, length);
+
+    this->packets++;
+    this->_windowPackets++;
+
+    if ((flags & DDP_FLAG_PUSH) != 0)
+    {
+      this->frames++;
+      returnValue = true;
+    }
+  }
+
+  return returnValue;
+}
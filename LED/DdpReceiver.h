@@ -0,0 +1,88 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef DDP_RECEIVER_H
+#define DDP_RECEIVER_H
+
+#include <Udp.h>
+#include <FastLED.h>
+#include "Ddp.h"
+
+//
+// Receives DDP packets into an LED array. This can be used to
+// drive a strip from a remote controller or as a loopback receiver
+// to verify the frames sent by DdpOutput and measure throughput
+// and latency.
+//
+class DdpReceiver
+{
+  public:
+    //
+    // Initializes the receiver:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  udp:            The UDP instance, already listening on the DDP port.
+    //
+    DdpReceiver(CRGB*, uint32_t, UDP*);
+    ~DdpReceiver();
+
+    //
+    // Reads a single packet if one is available. Returns true
+    // when a packet with the push flag set has been received
+    // and the LED array holds a complete frame.
+    //
+    bool poll();
+
+    //
+    // Clears the statistics.
+    //
+    void reset();
+
+    //
+    // Returns the number of packets received over the last
+    // complete second.
+    //
+    uint32_t packetsPerSecond();
+
+    //
+    // Statistics.
+    //
+    uint32_t packets = 0;
+    uint32_t frames = 0;
+    uint32_t invalid = 0;
+    uint32_t lost = 0;
+
+    //
+    // The latency, in µs, of the last packet that included a
+    // timecode. This is only meaningful when the sender and
+    // receiver share the same clock (loopback).
+    //
+    uint32_t latency = 0;
+
+  protected:
+    uint64_t _numberOfLeds = 0;
+    CRGB* _leds;
+    UDP* _udp;
+    uint8_t _sequence = 0;
+    uint32_t _windowStart = 0;
+    uint32_t _windowPackets = 0;
+    uint32_t _packetsPerSecond = 0;
+};
+#endif
@@ -0,0 +1,82 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef DITHER_OUTPUT_H
+#define DITHER_OUTPUT_H
+
+#include "IOutput.h"
+#include "HdrBuffer.h"
+#include "Trace.h"
+
+//
+// The default time, in ms, between refreshes of the dither
+// when the effect has not drawn a frame.
+//
+#define DITHER_REFRESH_INTERVAL   8
+
+//
+// This output reduces a 16-bit working buffer to the LED array
+// with temporal dithering and then displays it with another
+// output. The dither only looks smooth if it advances much more
+// often than the effect draws, so refresh() shows the buffer
+// again whenever the refresh interval has passed.
+//
+class DitherOutput : public IOutput
+{
+  public:
+    //
+    // Initializes the output:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  buffer:         The 16-bit buffer the effects draw into.
+    //  output:         The output that displays the LEDs.
+    //  interval:       Specifies the time, in ms, between refreshes.
+    //
+    DitherOutput(CRGB *leds, uint32_t numberOfLeds, HdrBuffer* buffer, IOutput* output, uint16_t interval = DITHER_REFRESH_INTERVAL) : IOutput(leds, numberOfLeds)
+    {
+      this->_buffer = buffer;
+      this->_output = output;
+      this->_interval = interval;
+    }
+
+    bool show()
+    {
+      {
+        TRACE_SCOPE(TRACE_POST);
+        this->_buffer->toRgb(this->_leds);
+      }
+
+      this->_lastShow = millis();
+
+      return this->_output->show();
+    }
+
+    bool refresh()
+    {
+      return (unsigned long)(millis() - this->_lastShow) >= this->_interval ? this->show() : false;
+    }
+
+  protected:
+    HdrBuffer* _buffer;
+    IOutput* _output;
+    uint16_t _interval = DITHER_REFRESH_INTERVAL;
+    unsigned long _lastShow = 0;
+};
+#endif
@@ -0,0 +1,74 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef E131_H
+#define E131_H
+
+//
+// Constants for E1.31 (Streaming ACN, sACN): DMX512 universes
+// carried over UDP. See ANSI E1.31-2018 for the protocol definition.
+//
+
+//
+// The UDP port E1.31 devices listen on. Universes are sent to
+// the multicast address 239.255.<universe high>.<universe low>.
+//
+#define E131_PORT                   5568
+
+//
+// A universe carries up to 512 channels; 170 RGB pixels fit
+// in one universe without splitting a pixel.
+//
+#define E131_CHANNELS               512
+#define E131_PIXELS_PER_UNIVERSE    170
+
+//
+// The root, framing and DMP layers before the channel data
+// (including the DMX start code).
+//
+#define E131_HEADER_LENGTH          126
+
+//
+// Offsets of the fields that change between packets.
+//
+#define E131_ROOT_LENGTH            16
+#define E131_CID                    22
+#define E131_FRAMING_LENGTH         38
+#define E131_SOURCE_NAME            44
+#define E131_SOURCE_NAME_LENGTH     64
+#define E131_PRIORITY               108
+#define E131_SEQUENCE               111
+#define E131_OPTIONS                112
+#define E131_UNIVERSE               113
+#define E131_DMP_LENGTH             115
+#define E131_PROPERTY_COUNT         123
+
+//
+// Vectors.
+//
+#define E131_VECTOR_ROOT_DATA       0x00000004
+#define E131_VECTOR_FRAMING_DATA    0x00000002
+#define E131_VECTOR_DMP_SET         0x02
+
+//
+// The default priority (0 to 200).
+//
+#define E131_DEFAULT_PRIORITY       100
+#endif
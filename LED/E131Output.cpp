@@ -0,0 +1,126 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "E131Output.h"
+
+//
+// Initialize the output sending each universe to its
+// multicast address.
+//
+E131Output::E131Output(CRGB *leds, uint32_t numberOfLeds, UDP *udp, uint16_t universe) : PacketOutput(leds, numberOfLeds, E131_PIXELS_PER_UNIVERSE)
+{
+  this->_udp = udp;
+  this->_universe = universe;
+
+  //
+  // Only the universes that have changed are sent so each
+  // universe has its own sequence number; a receiver sees
+  // it increase by one with every packet for its universe.
+  //
+  this->_sequences = new uint8_t[this->_numberOfPackets];
+  memset(this->_sequences, 0, this->_numberOfPackets);
+};
+
+//
+// Initialize the output sending every universe to a
+// single device.
+//
+E131Output::E131Output(CRGB *leds, uint32_t numberOfLeds, UDP *udp, uint16_t universe, IPAddress address, uint16_t port) : E131Output(leds, numberOfLeds, udp, universe)
+{
+  this->_multicast = false;
+  this->_address = address;
+  this->_port = port;
+};
+
+//
+// Deconstructor: release the sequence numbers.
+//
+E131Output::~E131Output()
+{
+  delete[] this->_sequences;
+};
+
+//
+// Writes a 16-bit value in network order.
+//
+static inline void e131Write16(uint8_t* data, uint16_t value)
+{
+  data[0] = (uint8_t)(value >> 8);
+  data[1] = (uint8_t)value;
+}
+
+static inline void e131Write32(uint8_t* data, uint32_t value)
+{
+  e131Write16(data, (uint16_t)(value >> 16));
+  e131Write16(data + 2, (uint16_t)value);
+}
+
+bool E131Output::sendPacket(uint32_t packet, bool /* last */)
+{
+  uint16_t universe = this->_universe + packet;
+  uint16_t channels = this->ledsInPacket(packet) * 3;
+  uint16_t length = E131_HEADER_LENGTH + channels;
+
+  //
+  // Root layer.
+  //
+  uint8_t header[E131_HEADER_LENGTH] = { 0x00, 0x10, 0x00, 0x00, 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00 };
+  e131Write16(&header[E131_ROOT_LENGTH], 0x7000 | (length - E131_ROOT_LENGTH));
+  e131Write32(&header[E131_ROOT_LENGTH + 2], E131_VECTOR_ROOT_DATA);
+  memcpy(&header[E131_CID], this->cid, sizeof(this->cid));
+
+  //
+  // Framing layer. The synchronization address (109) and
+  // options are left at 0.
+  //
+  e131Write16(&header[E131_FRAMING_LENGTH], 0x7000 | (length - E131_FRAMING_LENGTH));
+  e131Write32(&header[E131_FRAMING_LENGTH + 2], E131_VECTOR_FRAMING_DATA);
+  strncpy((char*)&header[E131_SOURCE_NAME], this->sourceName, E131_SOURCE_NAME_LENGTH - 1);
+  header[E131_PRIORITY] = this->priority;
+  header[E131_SEQUENCE] = this->_sequences[packet]++;
+  e131Write16(&header[E131_UNIVERSE], universe);
+
+  //
+  // DMP layer: the channels start at address 0 with an increment
+  // of 1 and are preceded by the DMX start code (0).
+  //
+  e131Write16(&header[E131_DMP_LENGTH], 0x7000 | (length - E131_DMP_LENGTH));
+  header[E131_DMP_LENGTH + 2] = E131_VECTOR_DMP_SET;
+  header[E131_DMP_LENGTH + 3] = 0xA1;
+  e131Write16(&header[E131_DMP_LENGTH + 6], 0x0001);
+  e131Write16(&header[E131_PROPERTY_COUNT], channels + 1);
+
+  IPAddress address = this->_multicast ? IPAddress(239, 255, (uint8_t)(universe >> 8), (uint8_t)universe) : this->_address;
+  bool returnValue = false;
+
+  if (this->_udp->beginPacket(address, this->_port))
+  {
+    //
+    // CRGB is stored as r, g, b which matches the channel order
+    // of an RGB fixture so the data is written directly from the
+    // LED array.
+    //
+    this->_udp->write(header, E131_HEADER_LENGTH);
+    this->_udp->write((const uint8_t*)&this->_leds[this->firstLed(packet)], channels);
+    returnValue = this->_udp->endPacket() == 1;
+  }
+
+  return returnValue;
+}
@@ -0,0 +1,76 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef E131_OUTPUT_H
+#define E131_OUTPUT_H
+
+#include <Udp.h>
+#include "PacketOutput.h"
+#include "E131.h"
+
+//
+// This output sends the LED array over UDP using E1.31 (sACN). The
+// array is split into universes of 170 pixels, numbered from the
+// first universe, and only the universes that have changed since
+// the last frame are sent. Each universe is sent to its multicast
+// address unless a unicast address is given.
+//
+// E1.31 has no equivalent of the DDP push flag; receivers display
+// each universe as it arrives.
+//
+class E131Output : public PacketOutput
+{
+  public:
+    //
+    // Initializes the output:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  udp:            The UDP instance (WiFiUDP, EthernetUDP, etc.) used to send packets.
+    //  universe:       The first universe (1 to 63999).
+    //  address:        The IP address of the E1.31 device (unicast).
+    //  port:           The UDP port of the E1.31 device.
+    //
+    E131Output(CRGB*, uint32_t, UDP*, uint16_t);
+    E131Output(CRGB*, uint32_t, UDP*, uint16_t, IPAddress, uint16_t);
+    ~E131Output();
+
+    //
+    // The priority of this source (0 to 200).
+    //
+    uint8_t priority = E131_DEFAULT_PRIORITY;
+
+    //
+    // Identifies this source to receivers. Change the CID when
+    // more than one controller sends to the same receivers.
+    //
+    uint8_t cid[16] = { 0x4c, 0x45, 0x44, 0x20, 0x53, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x63, 0x69, 0x6e, 0x67, 0x00, 0x01 };
+    const char* sourceName = "LED Sequencing";
+
+  protected:
+    bool sendPacket(uint32_t packet, bool last);
+
+    UDP* _udp;
+    uint16_t _universe = 1;
+    bool _multicast = true;
+    IPAddress _address;
+    uint16_t _port = E131_PORT;
+    uint8_t* _sequences;
+};
+#endif
@@ -0,0 +1,226 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef EFFECT_H
+#define EFFECT_H
+
+#include <FastLED.h>
+#include "FrameTimer.h"
+#include "Trace.h"
+
+//
+// A compile time alternative to IEffect. An effect derives from
+// Effect<T> passing itself as T (for example, class MyEffect : public
+// Effect<MyEffect>) and defines onAnimate() and, optionally, reset()
+// and seekFrame().
+// None of the methods are virtual so the compiler can inline
+// onAnimate() into animate() and setLed() into the drawing loops.
+//
+// The derived class must declare Effect<T> as a friend if onAnimate()
+// is not public. Use IEffect when effects must be selected through a
+// pointer at run-time and Effect<T> with EffectSet when the set of
+// effects is known at compile time.
+//
+template <class TEffect>
+class Effect
+{
+  public:
+    Effect(CRGB *leds, uint32_t numberOfLeds)
+    {
+      this->_leds = leds;
+      this->_numberOfLeds = numberOfLeds;
+    }
+
+    Effect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength)
+    {
+      this->_leds = leds;
+      this->_numberOfLeds = numberOfLeds;
+      this->frameLength = frameLength;
+    }
+
+    //
+    // Defines the number of milliseconds to display a given
+    // frame. The default value is 0 which disables animation.
+    //
+    uint64_t frameLength = 0;
+
+    //
+    // Returns true if the current frame has exceeded its time
+    // length and is ready to be moved to the next animation frame.
+    //
+    inline bool readyToAnimate()
+    {
+      return this->_timer.ready(this->frameLength);
+    }
+
+    //
+    // Animates the effect. This method can be called as often as
+    // possible.
+    //
+    inline bool animate()
+    {
+      bool returnValue = false;
+      bool ready = false;
+
+      {
+        TRACE_SCOPE(TRACE_READY);
+        ready = this->readyToAnimate();
+      }
+
+      if (ready)
+      {
+        TRACE_SCOPE(TRACE_ANIMATE);
+
+        if (this->_timer.jumped)
+        {
+          static_cast<TEffect*>(this)->seekFrame(this->_timer.frameNumber);
+        }
+
+        returnValue = static_cast<TEffect*>(this)->onAnimate();
+      }
+
+      return returnValue;
+    }
+
+    //
+    // Resets the effect to start at the beginning and clears
+    // the strip. An effect that hides this method should call
+    // it from its own reset().
+    //
+    inline bool reset()
+    {
+      this->_index = 0;
+      this->_timer.reset();
+
+      FastLED.clear();
+      FastLED.show();
+
+      return true;
+    }
+
+  protected:
+    //
+    // Peforms the work of a single frame of animation.
+    //
+    inline bool onAnimate()
+    {
+      return false;
+    }
+
+    //
+    // Moves the animation to where it is at the specified frame
+    // (see IEffect::seekFrame()). An effect with its own position
+    // hides this method.
+    //
+    inline void seekFrame(uint64_t frame)
+    {
+      this->_index = frame % this->_numberOfLeds;
+    }
+
+    //
+    // Increment _index keeping it within the
+    // bounds of the LED array.
+    //
+    inline void increment()
+    {
+      this->_index = (this->_index + 1) % this->_numberOfLeds;
+    }
+
+    //
+    // Sets the color of an LED ensuring the index specified
+    // is within the range of LEDs.
+    //
+    inline void setLed(int64_t index, CRGB rgb)
+    {
+      if (index >= 0 && (uint64_t)index < this->_numberOfLeds)
+      {
+        this->_leds[index] = rgb;
+      }
+    }
+
+    int64_t _index = 0;
+    uint64_t _numberOfLeds = 0;
+    FrameTimer _timer;
+    CRGB* _leds;
+};
+
+//
+// Holds a fixed set of effects by value and selects one by index.
+// Because the type of every effect is known, selecting an effect
+// compiles to a chain of comparisons (much like a switch) and each
+// effect's animate() is inlined; there are no virtual calls.
+//
+//  EffectSet<SparkEffect, WaveEffect> _effects(SparkEffect(...), WaveEffect(...));
+//  _effects.animate(_currentEffect);
+//
+template <class... TEffects>
+class EffectSet;
+
+template <>
+class EffectSet<>
+{
+  public:
+    static const uint8_t count = 0;
+
+    inline bool animate(uint8_t)
+    {
+      return false;
+    }
+
+    inline bool reset(uint8_t)
+    {
+      return false;
+    }
+};
+
+template <class TFirst, class... TRest>
+class EffectSet<TFirst, TRest...>
+{
+  public:
+    EffectSet(TFirst first, TRest... rest) : _first(first), _rest(rest...)
+    {
+    }
+
+    //
+    // The number of effects in the set.
+    //
+    static const uint8_t count = 1 + sizeof...(TRest);
+
+    //
+    // Animates the effect at the specified index.
+    //
+    inline bool animate(uint8_t index)
+    {
+      return index == 0 ? this->_first.animate() : this->_rest.animate(index - 1);
+    }
+
+    //
+    // Resets the effect at the specified index.
+    //
+    inline bool reset(uint8_t index)
+    {
+      return index == 0 ? this->_first.reset() : this->_rest.reset(index - 1);
+    }
+
+  private:
+    TFirst _first;
+    EffectSet<TRest...> _rest;
+};
+#endif
@@ -0,0 +1,48 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef FAST_LED_OUTPUT_H
+#define FAST_LED_OUTPUT_H
+
+#include "IOutput.h"
+
+//
+// This output displays the LED array on the strips that
+// have been registered with FastLED.addLeds().
+//
+class FastLedOutput : public IOutput
+{
+  public:
+    //
+    // Initializes the output:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //
+    FastLedOutput(CRGB *leds, uint32_t numberOfLeds) : IOutput(leds, numberOfLeds)
+    {
+    }
+
+    bool show()
+    {
+      FastLED.show();
+      return true;
+    }
+};
+#endif
@@ -0,0 +1,123 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Fft.h"
+#include "FixedMath.h"
+
+//
+// Initialize the transform with the number of samples.
+//
+Fft::Fft(uint16_t size)
+{
+  this->size = size;
+
+  while ((1U << this->_bits) < size)
+  {
+    this->_bits++;
+  }
+};
+
+void Fft::window(int16_t *real)
+{
+  //
+  // The Hann window is 0.5 - 0.5 * cos(2 * pi * i / size)
+  // in Q15. The angle step is 65536 / size.
+  //
+  uint16_t step = (uint16_t)(65536UL / this->size);
+
+  for (uint16_t i = 0; i < this->size; i++)
+  {
+    int32_t w = (32767 - (int32_t)FixedMath::Cos16(i * step)) >> 1;
+    real[i] = (int16_t)(((int32_t)real[i] * w) >> 15);
+  }
+}
+
+void Fft::transform(int16_t *real, int16_t *imaginary)
+{
+  uint16_t n = this->size;
+
+  //
+  // Reorder the samples into bit reversed order.
+  //
+  for (uint16_t i = 1; i < n; i++)
+  {
+    uint16_t j = 0;
+
+    for (uint8_t b = 0; b < this->_bits; b++)
+    {
+      j |= ((i >> b) & 0x01) << (this->_bits - 1 - b);
+    }
+
+    if (j > i)
+    {
+      int16_t t = real[i];
+      real[i] = real[j];
+      real[j] = t;
+
+      t = imaginary[i];
+      imaginary[i] = imaginary[j];
+      imaginary[j] = t;
+    }
+  }
+
+  //
+  // Combine the transforms of length half into transforms of
+  // length 2 * half. The twiddle factor for k is e^(-i * pi * k / half)
+  // where a full circle is 65536 so the angle is k * 32768 / half.
+  //
+  for (uint16_t half = 1; half < n; half <<= 1)
+  {
+    uint16_t step = (uint16_t)(32768UL / half);
+
+    for (uint16_t k = 0; k < half; k++)
+    {
+      int32_t wr = FixedMath::Cos16(k * step);
+      int32_t wi = -(int32_t)FixedMath::Sin16(k * step);
+
+      for (uint16_t i = k; i < n; i += half << 1)
+      {
+        uint16_t j = i + half;
+
+        int32_t tr = ((wr * real[j]) - (wi * imaginary[j])) >> 15;
+        int32_t ti = ((wr * imaginary[j]) + (wi * real[j])) >> 15;
+        int32_t qr = real[i];
+        int32_t qi = imaginary[i];
+
+        //
+        // Scale by 1/2 to prevent overflow.
+        //
+        real[j] = (int16_t)((qr - tr) >> 1);
+        imaginary[j] = (int16_t)((qi - ti) >> 1);
+        real[i] = (int16_t)((qr + tr) >> 1);
+        imaginary[i] = (int16_t)((qi + ti) >> 1);
+      }
+    }
+  }
+}
+
+void Fft::magnitudes(int16_t *real, int16_t *imaginary, uint16_t *magnitudes)
+{
+  for (uint16_t i = 0; i < (this->size >> 1); i++)
+  {
+    uint32_t r = (uint32_t)((int32_t)real[i] * real[i]);
+    uint32_t m = (uint32_t)((int32_t)imaginary[i] * imaginary[i]);
+    magnitudes[i] = FixedMath::Sqrt32(r + m);
+  }
+}
@@ -0,0 +1,66 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef FFT_H
+#define FFT_H
+
+#include <FastLED.h>
+
+//
+// A fixed-point radix-2 fast Fourier transform. The samples are
+// 16-bit and each stage of the transform is scaled by 1/2 so the
+// result cannot overflow; the output is the spectrum divided by
+// the size of the transform.
+//
+class Fft
+{
+  public:
+    //
+    // Initializes the transform:
+    //  size:   The number of samples, a power of 2 (64 to 256 are typical).
+    //
+    Fft(uint16_t);
+
+    //
+    // Multiplies the samples by a Hann window to reduce the
+    // leakage between bins.
+    //
+    void window(int16_t* real);
+
+    //
+    // Transforms the samples in place.
+    //
+    void transform(int16_t* real, int16_t* imaginary);
+
+    //
+    // Calculates the magnitude of the first size / 2 bins
+    // (the rest are a mirror image for real input).
+    //
+    void magnitudes(int16_t* real, int16_t* imaginary, uint16_t* magnitudes);
+
+    //
+    // The number of samples.
+    //
+    uint16_t size = 0;
+
+  protected:
+    uint8_t _bits = 0;
+};
+#endif
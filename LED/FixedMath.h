@@ -0,0 +1,394 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <FastLED.h>
+
+//
+// The first quarter of a sine wave, 0 to 90 degrees in 64 steps,
+// scaled to 127 and 32767. The rest of the wave is calculated from
+// the symmetry of the first quarter.
+//
+static const int8_t FIXED_MATH_SIN8[65] PROGMEM =
+{
+    0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,
+   40,  43,  46,  49,  51,  54,  57,  60,  63,  65,  68,  71,  73,
+   76,  78,  81,  83,  85,  88,  90,  92,  94,  96,  98, 100, 102,
+  104, 106, 107, 109, 111, 112, 113, 115, 116, 117, 118, 120, 121,
+  122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127, 127
+};
+
+static const int16_t FIXED_MATH_SIN16[65] PROGMEM =
+{
+      0,   804,  1608,  2410,  3212,  4011,  4808,  5602,  6393,  7179,  7962,  8739,  9512,
+  10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868,
+  19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811, 25329, 25832, 26319,
+  26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956, 30273, 30571, 30852, 31113,
+  31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757, 32767
+};
+
+//
+// The permutation table used to hash the lattice points of the
+// gradient noise (Ken Perlin's reference permutation).
+//
+static const uint8_t FIXED_MATH_PERMUTATION[256] PROGMEM =
+{
+  151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
+  140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
+  247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
+   57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
+   74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
+   60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
+   65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
+  200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
+   52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
+  207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
+  119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
+  129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
+  218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
+   81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
+  184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
+  222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180
+};
+
+//
+// Integer (fixed-point) math for effects that need to calculate
+// every LED on every frame. Everything is inline and uses lookup
+// tables in flash so it is fast on an 8-bit microcontroller where
+// floating point is done in software.
+//
+// Angles are expressed as a fraction of a full circle: 0 to 255
+// for the 8-bit functions and 0 to 65535 for the 16-bit functions.
+//
+// Where FastLED's lib8tion has the same function (qadd8, qsub8,
+// scale8 and sqrt16) it is called rather than repeated. The rest
+// differ from their FastLED counterparts on purpose:
+//
+//  - Sin16/Cos16 interpolate a table and are within four counts
+//    (0.01%) of the true value; FastLED's sin16 is an eight segment
+//    piecewise-linear fit that is off by up to about 0.7%, too much
+//    for the FFT's window and twiddle factors.
+//  - Sin8/Cos8 are signed; FastLED's sin8 is centered on 128.
+//  - Noise8 uses its own hash and fade, so it does not return the
+//    same values as FastLED's inoise8. PlasmaEffect is tuned to it.
+//  - FastLED has no 16-bit saturating math or 32-bit square root.
+//
+class FixedMath
+{
+  public:
+    //
+    // Returns the sine of an angle in the range -127 to 127.
+    //
+    static inline int8_t Sin8(uint8_t theta)
+    {
+      uint8_t index = theta & 0x3F;
+      uint8_t quadrant = theta >> 6;
+
+      if (quadrant & 0x01)
+      {
+        index = 64 - index;
+      }
+
+      int8_t returnValue = (int8_t)pgm_read_byte(&FIXED_MATH_SIN8[index]);
+
+      return (quadrant & 0x02) ? -returnValue : returnValue;
+    }
+
+    //
+    // Returns the cosine of an angle in the range -127 to 127.
+    //
+    static inline int8_t Cos8(uint8_t theta)
+    {
+      return FixedMath::Sin8(theta + 64);
+    }
+
+    //
+    // Returns the sine of an angle in the range -32767 to 32767
+    // interpolating between the entries of the table.
+    //
+    static inline int16_t Sin16(uint16_t theta)
+    {
+      uint16_t offset = theta & 0x3FFF;
+      uint8_t quadrant = theta >> 14;
+
+      if (quadrant & 0x01)
+      {
+        offset = 0x4000 - offset;
+      }
+
+      uint8_t index = offset >> 8;
+      uint8_t fraction = offset & 0xFF;
+      int16_t returnValue = (int16_t)pgm_read_word(&FIXED_MATH_SIN16[index]);
+
+      if (fraction != 0)
+      {
+        int16_t next = (int16_t)pgm_read_word(&FIXED_MATH_SIN16[index + 1]);
+        returnValue += (int16_t)(((int32_t)(next - returnValue) * fraction) >> 8);
+      }
+
+      return (quadrant & 0x02) ? -returnValue : returnValue;
+    }
+
+    //
+    // Returns the cosine of an angle in the range -32767 to 32767.
+    //
+    static inline int16_t Cos16(uint16_t theta)
+    {
+      return FixedMath::Sin16(theta + 16384);
+    }
+
+    //
+    // Returns the integer square root of a value.
+    //
+    static inline uint16_t Sqrt32(uint32_t value)
+    {
+      uint32_t returnValue = 0;
+      uint32_t bit = 1UL << 30;
+
+      while (bit > value)
+      {
+        bit >>= 2;
+      }
+
+      while (bit != 0)
+      {
+        if (value >= returnValue + bit)
+        {
+          value -= returnValue + bit;
+          returnValue = (returnValue >> 1) + bit;
+        }
+        else
+        {
+          returnValue >>= 1;
+        }
+
+        bit >>= 2;
+      }
+
+      return (uint16_t)returnValue;
+    }
+
+    static inline uint8_t Sqrt16(uint16_t value)
+    {
+      return sqrt16(value);
+    }
+
+    //
+    // Saturating addition and subtraction; the result is
+    // limited to the range of the type rather than wrapping.
+    //
+    static inline uint8_t QAdd8(uint8_t a, uint8_t b)
+    {
+      return qadd8(a, b);
+    }
+
+    static inline uint8_t QSub8(uint8_t a, uint8_t b)
+    {
+      return qsub8(a, b);
+    }
+
+    static inline uint16_t QAdd16(uint16_t a, uint16_t b)
+    {
+      uint32_t returnValue = (uint32_t)a + b;
+      return returnValue > 65535 ? 65535 : (uint16_t)returnValue;
+    }
+
+    static inline uint16_t QSub16(uint16_t a, uint16_t b)
+    {
+      return a > b ? a - b : 0;
+    }
+
+    //
+    // Scales a value by scale / 256.
+    //
+    static inline uint8_t Scale8(uint8_t value, uint8_t scale)
+    {
+      return scale8(value, scale);
+    }
+
+    //
+    // Linear interpolation from a to b where fraction is 0 to 255.
+    //
+    static inline uint8_t Lerp8(uint8_t a, uint8_t b, uint8_t fraction)
+    {
+      return (uint8_t)(a + (int16_t)(((int16_t)b - a) * fraction >> 8));
+    }
+
+    //
+    // Gradient noise. The coordinates are 8.8 fixed-point; the
+    // upper 8 bits select a cell in the lattice and the lower 8 bits
+    // are the position within the cell. Moving a coordinate smoothly
+    // gives a smoothly changing value in the range 0 to 255.
+    //
+    static inline uint8_t Noise8(uint16_t x)
+    {
+      uint8_t xi = x >> 8;
+      int16_t xf = x & 0xFF;
+
+      //
+      // Only the two ends of the segment are hashed.
+      //
+      int32_t n = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(xi), xf), FixedMath::gradient(FixedMath::permute(xi + 1), xf - 256), FixedMath::ease(xf));
+
+      //
+      // The result is roughly -1024 to 1024; center it on 128.
+      //
+      n = 128 + (n >> 3);
+
+      return n < 0 ? 0 : (n > 255 ? 255 : (uint8_t)n);
+    }
+
+    static inline uint8_t Noise8(uint16_t x, uint16_t y)
+    {
+      uint8_t xi = x >> 8;
+      uint8_t yi = y >> 8;
+      int16_t xf = x & 0xFF;
+      int16_t yf = y & 0xFF;
+
+      //
+      // Hash the four corners of the cell.
+      //
+      uint8_t a = FixedMath::permute(xi) + yi;
+      uint8_t b = FixedMath::permute(xi + 1) + yi;
+
+      int16_t u = FixedMath::ease(xf);
+      int16_t v = FixedMath::ease(yf);
+
+      int32_t x1 = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(a), xf, yf), FixedMath::gradient(FixedMath::permute(b), xf - 256, yf), u);
+      int32_t x2 = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(a + 1), xf, yf - 256), FixedMath::gradient(FixedMath::permute(b + 1), xf - 256, yf - 256), u);
+
+      int32_t n = FixedMath::lerp(x1, x2, v);
+
+      //
+      // The result is roughly -180 to 180; center it on 128.
+      //
+      n = 128 + ((n * 3) >> 2);
+
+      return n < 0 ? 0 : (n > 255 ? 255 : (uint8_t)n);
+    }
+
+    static inline uint8_t Noise8(uint16_t x, uint16_t y, uint16_t z)
+    {
+      uint8_t xi = x >> 8;
+      uint8_t yi = y >> 8;
+      uint8_t zi = z >> 8;
+      int16_t xf = x & 0xFF;
+      int16_t yf = y & 0xFF;
+      int16_t zf = z & 0xFF;
+
+      //
+      // Hash the eight corners of the cell.
+      //
+      uint8_t a = FixedMath::permute(xi) + yi;
+      uint8_t aa = FixedMath::permute(a) + zi;
+      uint8_t ab = FixedMath::permute(a + 1) + zi;
+      uint8_t b = FixedMath::permute(xi + 1) + yi;
+      uint8_t ba = FixedMath::permute(b) + zi;
+      uint8_t bb = FixedMath::permute(b + 1) + zi;
+
+      //
+      // Ease the position within the cell so the
+      // noise is smooth across cell boundaries.
+      //
+      int16_t u = FixedMath::ease(xf);
+      int16_t v = FixedMath::ease(yf);
+      int16_t w = FixedMath::ease(zf);
+
+      int32_t x1 = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(aa), xf, yf, zf), FixedMath::gradient(FixedMath::permute(ba), xf - 256, yf, zf), u);
+      int32_t x2 = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(ab), xf, yf - 256, zf), FixedMath::gradient(FixedMath::permute(bb), xf - 256, yf - 256, zf), u);
+      int32_t x3 = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(aa + 1), xf, yf, zf - 256), FixedMath::gradient(FixedMath::permute(ba + 1), xf - 256, yf, zf - 256), u);
+      int32_t x4 = FixedMath::lerp(FixedMath::gradient(FixedMath::permute(ab + 1), xf, yf - 256, zf - 256), FixedMath::gradient(FixedMath::permute(bb + 1), xf - 256, yf - 256, zf - 256), u);
+
+      int32_t n = FixedMath::lerp(FixedMath::lerp(x1, x2, v), FixedMath::lerp(x3, x4, v), w);
+
+      //
+      // The result is roughly -256 to 256; center it on 128.
+      //
+      n = 128 + (n >> 1);
+
+      return n < 0 ? 0 : (n > 255 ? 255 : (uint8_t)n);
+    }
+
+  private:
+    static inline uint8_t permute(uint8_t i)
+    {
+      return pgm_read_byte(&FIXED_MATH_PERMUTATION[i]);
+    }
+
+    //
+    // The smoothstep curve 3t^2 - 2t^3 for t in the range 0 to 256.
+    //
+    static inline int16_t ease(int16_t t)
+    {
+      return (int16_t)(((uint32_t)t * t * (768 - 2 * t)) >> 16);
+    }
+
+    static inline int32_t lerp(int32_t a, int32_t b, int16_t t)
+    {
+      return a + (((b - a) * t) >> 8);
+    }
+
+    //
+    // Returns the distance to the end of a segment multiplied by
+    // one of sixteen slopes (-8 to 8, but not 0) selected by the
+    // hash of the end.
+    //
+    static inline int16_t gradient(uint8_t hash, int16_t x)
+    {
+      int16_t slope = (hash & 0x07) + 1;
+
+      return (hash & 0x08) ? -(slope * x) : slope * x;
+    }
+
+    //
+    // Returns the dot product of the distance to a corner and one of
+    // eight gradient directions (the axes and diagonals) selected by
+    // the hash of the corner.
+    //
+    static inline int16_t gradient(uint8_t hash, int16_t x, int16_t y)
+    {
+      uint8_t h = hash & 0x07;
+
+      if (h < 4)
+      {
+        return ((h & 0x01) ? -x : x) + ((h & 0x02) ? -y : y);
+      }
+
+      int16_t u = (h & 0x02) ? y : x;
+
+      return (h & 0x01) ? -u : u;
+    }
+
+    //
+    // Returns the dot product of the distance to a corner and one of
+    // twelve gradient directions selected by the hash of the corner.
+    //
+    static inline int16_t gradient(uint8_t hash, int16_t x, int16_t y, int16_t z)
+    {
+      uint8_t h = hash & 0x0F;
+      int16_t u = h < 8 ? x : y;
+      int16_t v = h < 4 ? y : ((h == 12 || h == 14) ? x : z);
+
+      return ((h & 0x01) ? -u : u) + ((h & 0x02) ? -v : v);
+    }
+};
+#endif
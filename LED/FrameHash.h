@@ -0,0 +1,117 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef FRAME_HASH_H
+#define FRAME_HASH_H
+
+#include <FastLED.h>
+
+#define FRAME_HASH_PRIME1   2654435761UL
+#define FRAME_HASH_PRIME2   2246822519UL
+#define FRAME_HASH_PRIME3   3266489917UL
+#define FRAME_HASH_PRIME4   668265263UL
+#define FRAME_HASH_PRIME5   374761393UL
+
+//
+// Hashes the contents of an LED array with xxHash32 so that
+// frames can be compared without storing them.
+//
+class FrameHash
+{
+  public:
+    //
+    // Returns the hash of an LED array.
+    //
+    static inline uint32_t hash(const CRGB* leds, uint32_t numberOfLeds, uint32_t seed = 0)
+    {
+      return FrameHash::hash((const uint8_t*)leds, numberOfLeds * sizeof(CRGB), seed);
+    }
+
+    //
+    // Returns the xxHash32 of the data.
+    //
+    static uint32_t hash(const uint8_t* data, uint32_t length, uint32_t seed = 0)
+    {
+      const uint8_t* end = data + length;
+      uint32_t h;
+
+      if (length >= 16)
+      {
+        uint32_t v1 = seed + FRAME_HASH_PRIME1 + FRAME_HASH_PRIME2;
+        uint32_t v2 = seed + FRAME_HASH_PRIME2;
+        uint32_t v3 = seed;
+        uint32_t v4 = seed - FRAME_HASH_PRIME1;
+
+        for (; data + 16 <= end; data += 16)
+        {
+          v1 = FrameHash::round(v1, FrameHash::read(data));
+          v2 = FrameHash::round(v2, FrameHash::read(data + 4));
+          v3 = FrameHash::round(v3, FrameHash::read(data + 8));
+          v4 = FrameHash::round(v4, FrameHash::read(data + 12));
+        }
+
+        h = FrameHash::rotate(v1, 1) + FrameHash::rotate(v2, 7) + FrameHash::rotate(v3, 12) + FrameHash::rotate(v4, 18);
+      }
+      else
+      {
+        h = seed + FRAME_HASH_PRIME5;
+      }
+
+      h += length;
+
+      for (; data + 4 <= end; data += 4)
+      {
+        h = FrameHash::rotate(h + (FrameHash::read(data) * FRAME_HASH_PRIME3), 17) * FRAME_HASH_PRIME4;
+      }
+
+      for (; data < end; data++)
+      {
+        h = FrameHash::rotate(h + (*data * FRAME_HASH_PRIME5), 11) * FRAME_HASH_PRIME1;
+      }
+
+      h ^= h >> 15;
+      h *= FRAME_HASH_PRIME2;
+      h ^= h >> 13;
+      h *= FRAME_HASH_PRIME3;
+      h ^= h >> 16;
+
+      return h;
+    }
+
+  protected:
+    static inline uint32_t rotate(uint32_t value, uint8_t bits)
+    {
+      return (value << bits) | (value >> (32 - bits));
+    }
+
+    //
+    // Reads a little endian value from any alignment.
+    //
+    static inline uint32_t read(const uint8_t* data)
+    {
+      return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    }
+
+    static inline uint32_t round(uint32_t accumulator, uint32_t input)
+    {
+      return FrameHash::rotate(accumulator + (input * FRAME_HASH_PRIME2), 13) * FRAME_HASH_PRIME1;
+    }
+};
+#endif
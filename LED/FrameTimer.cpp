@@ -0,0 +1,48 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "FrameTimer.h"
+#include "Trace.h"
+
+#ifndef ARDUINO
+#include <mutex>
+
+//
+// The render engine's threads animate effects, and so
+// print warnings, at the same time.
+//
+static std::mutex _serialMutex;
+#endif
+
+void FrameTimer::late(uint64_t length)
+{
+#ifdef LED_TRACE
+  //
+  // Printing would delay the frame further; record it
+  // in the trace instead.
+  //
+  TRACE_EVENT(TRACE_LATE, (uint32_t)length);
+#else
+#ifndef ARDUINO
+  std::lock_guard<std::mutex> lock(_serialMutex);
+#endif
+  Serial.print("WARNING: frame rate too high! ["); Serial.print((float)length); Serial.println(" ms]");
+#endif
+}
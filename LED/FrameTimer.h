@@ -0,0 +1,144 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef FRAME_TIMER_H
+#define FRAME_TIMER_H
+
+#include <FastLED.h>
+#include "Clock.h"
+
+//
+// Decides when an effect moves to its next frame. Frames start on
+// multiples of the frame length, measured on Clock::now(), and are
+// numbered from the start of the clock so that controllers sharing
+// a clock advance together. IEffect and Effect<T> both use this so
+// their timing is the same.
+//
+class FrameTimer
+{
+  public:
+    //
+    // Returns true if a new frame of the specified length has
+    // started since the last frame. A length of 0 disables
+    // animation.
+    //
+    inline bool ready(uint64_t frameLength)
+    {
+      bool returnValue = false;
+
+      if (frameLength > 0)
+      {
+        //
+        // ready() can be called as often as possible, but an effect
+        // runs a specified rate. If it is not called often enough
+        // the effect may run slow.
+        //
+        uint64_t now = Clock::now();
+
+        //
+        // The clock may have stepped back (see SyncClock), in
+        // which case the frame is not late.
+        //
+        if (this->lastAnimationTime != 0 && now > this->lastAnimationTime + frameLength + 1)
+        {
+          FrameTimer::late(now - this->lastAnimationTime - frameLength);
+        }
+
+        uint64_t frameNumber = now / frameLength;
+
+        if (this->lastAnimationTime == 0 || frameNumber != this->frameNumber)
+        {
+          //
+          // The frame jumped if it does not follow the last one:
+          // the first frame after reset(), after frames were
+          // missed or after the clock stepped.
+          //
+          this->jumped = this->lastAnimationTime == 0 ? !this->_resume : frameNumber != this->frameNumber + 1;
+          this->_resume = false;
+
+          //
+          // Store the start of the frame; 0 is reserved to mean
+          // the effect has not animated yet.
+          //
+          this->frameNumber = frameNumber;
+          this->lastAnimationTime = frameNumber * frameLength;
+
+          if (this->lastAnimationTime == 0)
+          {
+            this->lastAnimationTime = 1;
+          }
+
+          returnValue = true;
+        }
+      }
+
+      return returnValue;
+    }
+
+    //
+    // Starts the next frame immediately.
+    //
+    inline void reset()
+    {
+      this->lastAnimationTime = 0;
+      this->_resume = false;
+    }
+
+    //
+    // Starts the next frame immediately without it counting
+    // as a jump, so a restored effect continues from where
+    // it was saved.
+    //
+    inline void resume()
+    {
+      this->lastAnimationTime = 0;
+      this->_resume = true;
+    }
+
+    //
+    // The start of the current frame; 0 until the first frame.
+    //
+    uint64_t lastAnimationTime = 0;
+
+    //
+    // The number of the current frame since the clock started.
+    //
+    uint64_t frameNumber = 0;
+
+    //
+    // True when the frame ready() started does not follow the
+    // previous one. The effect should then move to the position
+    // it has at frameNumber (see IEffect::seekFrame()) so that
+    // controllers sharing a clock show the same frame however
+    // long each has been running.
+    //
+    bool jumped = false;
+
+  protected:
+    //
+    // Reports a frame that started the specified number of ms
+    // late: in the trace when it is enabled, otherwise as a
+    // warning on the serial port.
+    //
+    static void late(uint64_t length);
+
+    bool _resume = false;
+};
+#endif
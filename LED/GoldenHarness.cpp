@@ -0,0 +1,190 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "GoldenHarness.h"
+
+#ifndef ARDUINO
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include "FrameHash.h"
+
+GoldenHarness::GoldenHarness(CRGB* leds, uint32_t numberOfLeds)
+{
+  this->_leds = leds;
+  this->_numberOfLeds = numberOfLeds;
+}
+
+void GoldenHarness::run(IEffect* effect, uint32_t frames)
+{
+  uint64_t elapsed = 0;
+
+  this->hashes.clear();
+  this->_frames.clear();
+  this->_frames.reserve((size_t)frames * this->_numberOfLeds);
+
+  //
+  // Start every run from the same time and a blank frame.
+  //
+  this->_clock.time = 0;
+  Clock::use(&this->_clock);
+  memset((void*)this->_leds, 0, this->_numberOfLeds * sizeof(CRGB));
+  effect->reset();
+
+  for (uint32_t i = 0; i < frames; i++)
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    effect->animate();
+    elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    this->hashes.push_back(FrameHash::hash(this->_leds, this->_numberOfLeds));
+    this->_frames.insert(this->_frames.end(), this->_leds, this->_leds + this->_numberOfLeds);
+
+    //
+    // Move to the start of the next frame so the effect draws
+    // exactly once per frame and frame i is frame number i.
+    //
+    this->_clock.advance(effect->frameLength > 0 ? effect->frameLength : 1);
+  }
+
+  Clock::use(NULL);
+  this->nanosecondsPerFrame = frames > 0 ? (double)elapsed / frames : 0.0;
+}
+
+bool GoldenHarness::write(const char* path)
+{
+  FILE* file = fopen(path, "w");
+
+  if (file == NULL)
+  {
+    return false;
+  }
+
+  fprintf(file, "# %u %u\n", (unsigned)this->hashes.size(), (unsigned)this->_numberOfLeds);
+
+  for (uint32_t i = 0; i < this->hashes.size(); i++)
+  {
+    const CRGB* frame = &this->_frames[(size_t)i * this->_numberOfLeds];
+
+    fprintf(file, "%u %08" PRIx32 " ", (unsigned)i, this->hashes[i]);
+
+    for (uint32_t j = 0; j < this->_numberOfLeds; j++)
+    {
+      fprintf(file, "%02x%02x%02x", frame[j].r, frame[j].g, frame[j].b);
+    }
+
+    fprintf(file, "\n");
+  }
+
+  return fclose(file) == 0;
+}
+
+GoldenResult GoldenHarness::compare(const char* path, uint8_t tolerance)
+{
+  GoldenResult result;
+  result.nanosecondsPerFrame = this->nanosecondsPerFrame;
+
+  FILE* file = fopen(path, "r");
+
+  if (file == NULL)
+  {
+    return result;
+  }
+
+  unsigned frames = 0;
+  unsigned numberOfLeds = 0;
+
+  if (fscanf(file, " # %u %u", &frames, &numberOfLeds) == 2 && numberOfLeds == this->_numberOfLeds && frames == this->hashes.size())
+  {
+    result.frames = frames;
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+      unsigned index = 0;
+      uint32_t hash = 0;
+
+      if (fscanf(file, " %u %" SCNx32 " ", &index, &hash) != 2 || index != i)
+      {
+        result.mismatched = frames - i;
+        result.firstMismatch = result.firstMismatch < 0 ? (int32_t)i : result.firstMismatch;
+        break;
+      }
+
+      //
+      // Read the LEDs even when the hash matches so the
+      // next line is found.
+      //
+      const CRGB* frame = &this->_frames[(size_t)i * this->_numberOfLeds];
+      bool complete = true;
+      uint8_t frameDifference = 0;
+
+      for (uint32_t j = 0; j < numberOfLeds; j++)
+      {
+        unsigned r = 0, g = 0, b = 0;
+
+        if (fscanf(file, "%2x%2x%2x", &r, &g, &b) != 3)
+        {
+          complete = false;
+          break;
+        }
+
+        frameDifference = std::max(frameDifference, (uint8_t)abs((int)frame[j].r - (int)r));
+        frameDifference = std::max(frameDifference, (uint8_t)abs((int)frame[j].g - (int)g));
+        frameDifference = std::max(frameDifference, (uint8_t)abs((int)frame[j].b - (int)b));
+      }
+
+      result.maximumDifference = std::max(result.maximumDifference, frameDifference);
+
+      //
+      // With a tolerance, a frame whose hash differs still
+      // matches if no channel is off by more than it.
+      //
+      bool matched = complete && (hash == this->hashes[i] || (tolerance > 0 && frameDifference <= tolerance));
+
+      if (!matched)
+      {
+        result.mismatched++;
+        result.firstMismatch = result.firstMismatch < 0 ? (int32_t)i : result.firstMismatch;
+      }
+    }
+
+    result.passed = result.mismatched == 0;
+  }
+
+  fclose(file);
+
+  return result;
+}
+
+void GoldenHarness::report(FILE* file, const char* name, const GoldenResult& result)
+{
+  fprintf(file, "%-24s %s  %u/%u frames matched", name, result.passed ? "PASS" : "FAIL",
+          (unsigned)(result.frames - result.mismatched), (unsigned)result.frames);
+
+  if (result.firstMismatch >= 0)
+  {
+    fprintf(file, " (first mismatch at frame %d)", (int)result.firstMismatch);
+  }
+
+  fprintf(file, "  max difference %u  %.0f ns/frame\n", (unsigned)result.maximumDifference, result.nanosecondsPerFrame);
+}
+#endif
@@ -0,0 +1,123 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef GOLDEN_HARNESS_H
+#define GOLDEN_HARNESS_H
+
+//
+// The golden harness runs on the host.
+//
+#ifndef ARDUINO
+#include <cstdio>
+#include <vector>
+#include "IEffect.h"
+#include "Clock.h"
+
+//
+// The result of comparing a run with a golden file.
+//
+struct GoldenResult
+{
+  //
+  // True if every frame matched (within the tolerance).
+  //
+  bool passed = false;
+
+  uint32_t frames = 0;
+  uint32_t mismatched = 0;
+
+  //
+  // The first frame that did not match, or -1.
+  //
+  int32_t firstMismatch = -1;
+
+  //
+  // The largest difference in any channel of any frame.
+  //
+  uint8_t maximumDifference = 0;
+
+  //
+  // The average time spent in animate() per frame.
+  //
+  double nanosecondsPerFrame = 0.0;
+};
+
+//
+// Runs an effect frame by frame with a ManualClock, so the frames
+// do not depend on how fast the host is, and hashes each frame
+// (see FrameHash). The frames can be written to a golden file and
+// later runs compared with it, to make sure that an optimized
+// implementation draws the same frames.
+//
+// A golden file is text: a header line (# frames leds) followed by
+// a line for each frame with the frame number, its hash and the
+// LEDs in hex. Comparing with a tolerance of 0 only compares the
+// hashes; otherwise frames whose hashes differ match if no channel
+// differs by more than the tolerance.
+//
+class GoldenHarness
+{
+  public:
+    //
+    // Initializes the harness with the LED array the
+    // effects draw into.
+    //
+    GoldenHarness(CRGB* leds, uint32_t numberOfLeds);
+
+    //
+    // Resets the effect and runs it for the specified number
+    // of frames, keeping each frame.
+    //
+    void run(IEffect* effect, uint32_t frames);
+
+    //
+    // Writes the frames of the last run to a golden file.
+    //
+    bool write(const char* path);
+
+    //
+    // Compares the frames of the last run with a golden file.
+    //
+    GoldenResult compare(const char* path, uint8_t tolerance);
+
+    //
+    // Writes a line describing the result.
+    //
+    static void report(FILE* file, const char* name, const GoldenResult& result);
+
+    //
+    // The hash of each frame and the average time per frame
+    // of the last run.
+    //
+    std::vector<uint32_t> hashes;
+    double nanosecondsPerFrame = 0.0;
+
+  protected:
+    CRGB* _leds;
+    uint32_t _numberOfLeds = 0;
+    ManualClock _clock;
+
+    //
+    // Every frame of the last run.
+    //
+    std::vector<CRGB> _frames;
+};
+#endif
+#endif
@@ -0,0 +1,74 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "HdrBuffer.h"
+
+HdrBuffer::HdrBuffer(uint32_t numberOfLeds)
+{
+  this->_numberOfLeds = numberOfLeds;
+  this->_pixels = new CRGB16[numberOfLeds];
+  this->_residue = new uint8_t[numberOfLeds * 3];
+
+  //
+  // Start the remainders at different values so that LEDs
+  // with the same color do not all step on the same frame.
+  //
+  for (uint32_t i = 0; i < numberOfLeds * 3; i++)
+  {
+    this->_residue[i] = (uint8_t)(i * 97);
+  }
+}
+
+HdrBuffer::~HdrBuffer()
+{
+  delete[] this->_pixels;
+  delete[] this->_residue;
+}
+
+void HdrBuffer::clear()
+{
+  memset((void*)this->_pixels, 0, this->_numberOfLeds * sizeof(CRGB16));
+}
+
+void HdrBuffer::toRgb(CRGB* leds)
+{
+  //
+  // CRGB16 and CRGB are packed channels, so the buffers are
+  // treated as flat arrays. The loop has no branches so the
+  // compiler can vectorize it.
+  //
+  const uint16_t* source = (const uint16_t*)this->_pixels;
+  uint8_t* residue = this->_residue;
+  uint8_t* target = (uint8_t*)leds;
+  uint32_t count = this->_numberOfLeds * 3;
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    uint32_t value = (uint32_t)source[i] + residue[i];
+    uint32_t high = value >> 8;
+
+    //
+    // A full channel plus a remainder would overflow; it is
+    // shown as full.
+    //
+    target[i] = (uint8_t)(high > 255 ? 255 : high);
+    residue[i] = (uint8_t)value;
+  }
+}
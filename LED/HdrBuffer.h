@@ -0,0 +1,90 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef HDR_BUFFER_H
+#define HDR_BUFFER_H
+
+#include "CRGB16.h"
+
+//
+// A working frame buffer with 16 bits per channel. Effects draw
+// into it and toRgb() reduces it to the CRGB LED array just before
+// it is displayed.
+//
+// The reduction uses temporal dithering: the part of each channel
+// that is lost when it is reduced to 8 bits is carried to the next
+// frame, so a channel of 0x0040 (a quarter of the lowest 8-bit step)
+// is shown as 1 on one frame in four rather than always 0. Dithering
+// is only smooth when toRgb() and show() are called much more often
+// than the effect draws.
+//
+class HdrBuffer
+{
+  public:
+    HdrBuffer(uint32_t numberOfLeds);
+    ~HdrBuffer();
+
+    //
+    // Sets every LED to black.
+    //
+    void clear();
+
+    //
+    // Sets the color of an LED; an index outside the
+    // buffer is ignored.
+    //
+    inline void setLed(int64_t index, const CRGB16& rgb)
+    {
+      if (index >= 0 && index < (int64_t)this->_numberOfLeds)
+      {
+        this->_pixels[index] = rgb;
+      }
+    }
+
+    //
+    // Returns the LEDs for effects that draw directly.
+    //
+    inline CRGB16* pixels()
+    {
+      return this->_pixels;
+    }
+
+    inline uint32_t numberOfLeds()
+    {
+      return this->_numberOfLeds;
+    }
+
+    //
+    // Reduces the buffer to 8 bits per channel with temporal
+    // dithering and writes it to the LED array.
+    //
+    void toRgb(CRGB* leds);
+
+  protected:
+    uint32_t _numberOfLeds = 0;
+    CRGB16* _pixels;
+
+    //
+    // The remainder of each channel carried to the next
+    // frame.
+    //
+    uint8_t* _residue;
+};
+#endif
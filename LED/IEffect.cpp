@@ -19,6 +19,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "IEffect.h"
+#include "Trace.h"
 
 //
 // Initialize the effect with an LED array and the number of LEDs.
@@ -63,9 +64,22 @@ IEffect::~IEffect()
 bool IEffect::animate()
 {
   bool returnValue = false;
+  bool ready = false;
 
-  if (this->readyToAnimate())
   {
+    TRACE_SCOPE(TRACE_READY);
+    ready = this->readyToAnimate();
+  }
+
+  if (ready)
+  {
+    TRACE_SCOPE(TRACE_ANIMATE);
+
+    if (this->_timer.jumped)
+    {
+      this->seekFrame(this->_timer.frameNumber);
+    }
+
     returnValue = this->onAnimate();
   }
 
@@ -120,10 +134,9 @@ bool IEffect::reset()
   this->_index = 0;
 
   //
-  // Set the last animation time to 0 so the next
-  // animation starts immediately.
+  // Start the next animation immediately.
   //
-  this->_lastAnimationTime = 0;
+  this->_timer.reset();
 
   //
   // Clear the strip.
@@ -135,40 +148,80 @@ bool IEffect::reset()
 };
 
 //
-// The default implementation checks the last animation
-// time against the frame length and returns true if the
-// current frame has expired.
+// The default implementation supports changing the frame length.
 //
-bool IEffect::readyToAnimate()
+bool IEffect::setParameter(uint8_t parameter, uint32_t value)
 {
   bool returnValue = false;
 
-  //
-  // Only animate if frame length is greater than 0.
-  //
-  if (this->frameLength > 0)
+  if (parameter == PARAMETER_FRAME_LENGTH)
   {
-    //
-    // animate() can be called as often as possible, but an effect
-    // runs a specified rate. If animate() is not called often enough
-    // the effect may run slow.
-    //
-    uint64_t lastAnimation = millis() - this->_lastAnimationTime;
+    this->frameLength = value;
+    returnValue = true;
+  }
 
-    if (this->_lastAnimationTime != 0 && lastAnimation > (this->frameLength + 1))
-    {
-      Serial.print("WARNING: frame rate too high! ["); Serial.print((float)(lastAnimation - this->frameLength)); Serial.println(" ms]");
-    }
+  return returnValue;
+};
 
-    if (this->_lastAnimationTime == 0 || lastAnimation >= this->frameLength)
-    {
-      //
-      // Get and store the value of millis()
-      //
-      this->_lastAnimationTime = millis();
-      returnValue = true;
-    }
+//
+// The default implementation saves the frame length and
+// the current LED.
+//
+uint8_t IEffect::saveState(uint8_t *state)
+{
+  uint32_t frameLength = (uint32_t)this->frameLength;
+  int32_t index = (int32_t)this->_index;
+
+  memcpy(&state[0], &frameLength, sizeof(frameLength));
+  memcpy(&state[4], &index, sizeof(index));
+
+  return EFFECT_BASE_STATE_LENGTH;
+};
+
+//
+// The default implementation restores the frame length
+// and the current LED.
+//
+bool IEffect::restoreState(const uint8_t *state, uint8_t length)
+{
+  bool returnValue = false;
+
+  if (length >= EFFECT_BASE_STATE_LENGTH)
+  {
+    uint32_t frameLength;
+    int32_t index;
+
+    memcpy(&frameLength, &state[0], sizeof(frameLength));
+    memcpy(&index, &state[4], sizeof(index));
+
+    this->frameLength = frameLength;
+    this->_index = index;
+
+    //
+    // Continue from the restored position rather than
+    // the frame the clock is on.
+    //
+    this->_timer.resume();
+    returnValue = true;
   }
 
   return returnValue;
 };
+
+//
+// The default implementation moves the current LED to
+// where increment() would have left it.
+//
+void IEffect::seekFrame(uint64_t frame)
+{
+  this->_index = frame % this->_numberOfLeds;
+};
+
+//
+// The default implementation starts a frame on each
+// multiple of the frame length (see FrameTimer).
+//
+bool IEffect::readyToAnimate()
+{
+  return this->_timer.ready(this->frameLength);
+};
@@ -22,6 +22,24 @@
 #define I_EFFECT_H
 
 #include <FastLED.h>
+#include "FrameTimer.h"
+
+//
+// Identifies the parameters that can be changed with
+// setParameter(). An effect only supports the parameters
+// that apply to it.
+//
+#define PARAMETER_FRAME_LENGTH    0   // The frame length in ms.
+#define PARAMETER_COLOR           1   // The color as 0xRRGGBB.
+#define PARAMETER_LENGTH          2   // The length of a tail or stripe in LEDs.
+#define PARAMETER_FADE            3   // The fade factor in thousandths.
+
+//
+// The maximum number of bytes of state saved by saveState()
+// and the number of those bytes used by IEffect.
+//
+#define EFFECT_STATE_LENGTH       24
+#define EFFECT_BASE_STATE_LENGTH  8
 
 //
 // Defines the interface for an LED animation effect.
@@ -31,7 +49,7 @@ class IEffect
   public:
     IEffect(CRGB*, uint32_t);
     IEffect(CRGB*, uint32_t, uint64_t);
-    ~IEffect();
+    virtual ~IEffect();
 
     //
     // Defines the number of milliseconds to display a given frame. One frame
@@ -62,6 +80,38 @@ class IEffect
     //
     virtual bool reset();
 
+    //
+    // Sets a parameter of the effect (see PARAMETER_*). Returns
+    // false if the effect does not support the parameter. The
+    // default implementation supports the frame length.
+    //
+    virtual bool setParameter(uint8_t parameter, uint32_t value);
+
+    //
+    // Saves the parameters and animation state of the effect into
+    // state (at most EFFECT_STATE_LENGTH bytes) and returns the
+    // number of bytes saved. An effect that overrides this should
+    // call the base first and append its own state.
+    //
+    virtual uint8_t saveState(uint8_t* state);
+
+    //
+    // Restores the state saved by saveState(). This is called after
+    // reset() so the effect continues where it left off. Returns
+    // false if the state is not valid for the effect.
+    //
+    virtual bool restoreState(const uint8_t* state, uint8_t length);
+
+    //
+    // Moves the animation to where it is at the specified frame
+    // (FrameTimer::frameNumber) as if it had been animating since
+    // the clock started. animate() calls this on the first frame
+    // after reset() and when frames were missed or the clock
+    // stepped, so effects on controllers sharing a clock stay in
+    // step. The default implementation moves the current LED.
+    //
+    virtual void seekFrame(uint64_t frame);
+
   protected:
     //
     // Peforms the work of a single frame of animation.
@@ -93,9 +143,9 @@ class IEffect
     uint64_t _numberOfLeds = 0;
 
     //
-    // Marks the last time the sequence/animation was advanced.
+    // Decides when the next frame starts.
     //
-    uint64_t _lastAnimationTime = 0;
+    FrameTimer _timer;
 
     //
     // Array of LEDs.
@@ -0,0 +1,46 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "IEffect2D.h"
+
+//
+// Initialize the effect with an LED array and the layout.
+//
+IEffect2D::IEffect2D(CRGB *leds, Layout *layout) : IEffect(leds, layout->numberOfLeds)
+{
+  this->_layout = layout;
+};
+
+//
+// Initialize the effect with an LED array, the layout,
+// and the frame length.
+//
+IEffect2D::IEffect2D(CRGB *leds, Layout *layout, uint64_t frameLength) : IEffect(leds, layout->numberOfLeds, frameLength)
+{
+  this->_layout = layout;
+};
+
+//
+// Deconstructor: remove the reference to the layout.
+//
+IEffect2D::~IEffect2D()
+{
+  this->_layout = NULL;
+};
@@ -0,0 +1,62 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef I_EFFECT_2D_H
+#define I_EFFECT_2D_H
+
+#include "IEffect.h"
+#include "Layout.h"
+
+//
+// Defines the interface for an LED animation effect that draws
+// in the logical (x, y) space of a layout rather than directly
+// on the physical LED indexes.
+//
+class IEffect2D : public IEffect
+{
+  public:
+    IEffect2D(CRGB*, Layout*);
+    IEffect2D(CRGB*, Layout*, uint64_t);
+    virtual ~IEffect2D();
+
+  protected:
+    using IEffect::setLed;
+
+    //
+    // Sets the color of the LED at a logical position. Positions
+    // outside of the layout or without an LED are ignored so the
+    // frame can be drawn "offscreen".
+    //
+    inline void setLed(int32_t x, int32_t y, CRGB rgb)
+    {
+      int32_t i = this->_layout->index(x, y);
+
+      if (i >= 0)
+      {
+        this->_leds[i] = rgb;
+      }
+    }
+
+    //
+    // The layout of the LEDs.
+    //
+    Layout* _layout;
+};
+#endif
@@ -0,0 +1,54 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "IOutput.h"
+
+//
+// Initialize the output with an LED array and the number of LEDs.
+//
+IOutput::IOutput(CRGB *leds, uint32_t numberOfLeds)
+{
+  this->_leds = leds;
+  this->_numberOfLeds = numberOfLeds;
+};
+
+//
+// Deconstructor: remove the reference to the LEDs.
+//
+IOutput::~IOutput()
+{
+  this->_leds = NULL;
+};
+
+//
+// The default implementation does not send anything.
+//
+bool IOutput::show()
+{
+  return false;
+};
+
+//
+// Most outputs only change when a frame is drawn.
+//
+bool IOutput::refresh()
+{
+  return false;
+};
@@ -0,0 +1,63 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef I_OUTPUT_H
+#define I_OUTPUT_H
+
+#include <FastLED.h>
+
+//
+// Defines the interface for an output that sends the contents
+// of an LED array to the physical (or remote) LEDs. Effects draw
+// into the LED array and an output is used to display it.
+//
+class IOutput
+{
+  public:
+    IOutput(CRGB*, uint32_t);
+    virtual ~IOutput();
+
+    //
+    // Sends the current contents of the LED array to the
+    // LEDs. Returns true if anything was sent.
+    //
+    virtual bool show();
+
+    //
+    // Called on every pass through loop() that does not draw a
+    // frame. Outputs that change the LEDs between frames (such as
+    // DitherOutput) or must resend them periodically (such as the
+    // network outputs) show them again. Returns true if anything
+    // was sent.
+    //
+    virtual bool refresh();
+
+  protected:
+    //
+    // The number of LEDs.
+    //
+    uint64_t _numberOfLeds = 0;
+
+    //
+    // Array of LEDs.
+    //
+    CRGB* _leds;
+};
+#endif
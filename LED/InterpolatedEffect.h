@@ -0,0 +1,149 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "IEffect.h"
+#include "Clock.h"
+
+//
+// This effect smooths the motion of another effect. The other effect
+// draws its frames into a separate LED array at its own (low) frame
+// rate and this effect blends from the previously displayed frame to
+// the latest one at a higher frame rate. The motion appears smooth
+// without the other effect having to calculate more frames.
+//
+class InterpolatedEffect : public IEffect
+{
+  public:
+    //
+    // Initializes the effect:
+    //  leds:           The array of LEDs that are displayed.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  frameLength:    Specifies the length of time, in ms, to display a single
+    //                  blended frame. This is typically the refresh rate of the strip.
+    //  effect:         The effect to smooth.
+    //  frame:          The array of LEDs the effect draws into. This must not be
+    //                  the same array as leds.
+    //
+    InterpolatedEffect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength, IEffect *effect, CRGB *frame) : IEffect(leds, numberOfLeds, frameLength)
+    {
+      this->_effect = effect;
+      this->_frame = frame;
+      this->_previous = new CRGB[numberOfLeds];
+    }
+
+    ~InterpolatedEffect()
+    {
+      delete[] this->_previous;
+      this->_effect = NULL;
+      this->_frame = NULL;
+    }
+
+    //
+    // Resets this animation effect and the effect being
+    // smoothed and then calls the base implementation.
+    //
+    bool reset()
+    {
+      //
+      // The effect's reset() clears the LEDs registered with
+      // FastLED but not the array it draws into so clear the
+      // arrays here. The displayed LEDs are cleared as well
+      // since they may not be registered (such as on a strip
+      // driven by an IOutput) and the next blend starts from
+      // them.
+      //
+      memset((void*)this->_leds, 0, this->_numberOfLeds * sizeof(CRGB));
+      memset((void*)this->_frame, 0, this->_numberOfLeds * sizeof(CRGB));
+      memset((void*)this->_previous, 0, this->_numberOfLeds * sizeof(CRGB));
+      this->_effect->reset();
+      this->_fraction = 0;
+
+      //
+      // Call the base reset.
+      //
+      return IEffect::reset();
+    }
+
+  protected:
+    bool onAnimate()
+    {
+      //
+      // When the effect draws a new frame the frame currently
+      // displayed becomes the starting point of the blend.
+      //
+      bool newFrame = false;
+
+      if (this->_effect->animate())
+      {
+        memcpy((void*)this->_previous, (const void*)this->_leds, this->_numberOfLeds * sizeof(CRGB));
+        this->_frameStart = Clock::now();
+        newFrame = true;
+      }
+
+      //
+      // Calculate how far into the effect's frame the current
+      // time is in the range 0 to 256.
+      //
+      uint16_t fraction = 256;
+
+      if (this->_effect->frameLength > 0)
+      {
+        uint64_t elapsed = Clock::now() - this->_frameStart;
+        fraction = elapsed >= this->_effect->frameLength ? 256 : (uint16_t)((elapsed * 256) / this->_effect->frameLength);
+      }
+
+      //
+      // Nothing has changed since the last blend.
+      //
+      if (!newFrame && fraction == this->_fraction)
+      {
+        return false;
+      }
+
+      this->_fraction = fraction;
+
+      if (fraction >= 256)
+      {
+        //
+        // The blend is complete; display the effect's frame.
+        //
+        memcpy((void*)this->_leds, (const void*)this->_frame, this->_numberOfLeds * sizeof(CRGB));
+      }
+      else
+      {
+        for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+        {
+          this->_leds[i] = blend(this->_previous[i], this->_frame[i], (fract8)fraction);
+        }
+      }
+
+      //
+      // Return true since the animation was changed.
+      //
+      return true;
+    }
+
+  private:
+    IEffect* _effect;
+    CRGB* _frame;
+    CRGB* _previous;
+    uint64_t _frameStart = 0;
+    uint16_t _fraction = 0;
+};
@@ -0,0 +1,131 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Layout.h"
+
+//
+// Initialize an empty layout with the size of the logical
+// space and the number of physical LEDs.
+//
+Layout::Layout(uint16_t width, uint16_t height, uint16_t numberOfLeds)
+{
+  this->width = width;
+  this->height = height;
+  this->numberOfLeds = numberOfLeds;
+
+  this->_map = new uint16_t[(uint32_t)width * height];
+  this->x = new uint8_t[numberOfLeds];
+  this->y = new uint8_t[numberOfLeds];
+
+  for (uint32_t i = 0; i < (uint32_t)width * height; i++)
+  {
+    this->_map[i] = LAYOUT_NONE;
+  }
+
+  for (uint16_t i = 0; i < numberOfLeds; i++)
+  {
+    this->x[i] = 0;
+    this->y[i] = 0;
+  }
+};
+
+//
+// Deconstructor: release the tables.
+//
+Layout::~Layout()
+{
+  delete[] this->_map;
+  delete[] this->x;
+  delete[] this->y;
+};
+
+void Layout::map(uint16_t x, uint16_t y, uint16_t index)
+{
+  if (x < this->width && y < this->height && index < this->numberOfLeds)
+  {
+    this->_map[((uint32_t)y * this->width) + x] = index;
+  }
+}
+
+void Layout::position(uint16_t index, uint8_t x, uint8_t y)
+{
+  if (index < this->numberOfLeds)
+  {
+    this->x[index] = x;
+    this->y[index] = y;
+  }
+}
+
+Layout* Layout::matrix(uint16_t width, uint16_t height, bool serpentine)
+{
+  Layout* returnValue = NULL;
+
+  //
+  // A larger matrix would wrap the 16-bit indexes.
+  //
+  if ((uint32_t)width * height <= LAYOUT_MAXIMUM_LEDS)
+  {
+    returnValue = new Layout(width, height, width * height);
+
+    for (uint16_t y = 0; y < height; y++)
+    {
+      for (uint16_t x = 0; x < width; x++)
+      {
+        //
+        // On a serpentine matrix the odd rows run right to left.
+        //
+        uint16_t column = (serpentine && (y % 2) == 1) ? (width - 1 - x) : x;
+        uint16_t index = (y * width) + column;
+
+        returnValue->map(x, y, index);
+
+        //
+        // Scale the position so the first and last rows and
+        // columns are at the edges of the normalized space.
+        //
+        returnValue->position(index,
+                              width > 1 ? (uint8_t)((255UL * x) / (width - 1)) : 0,
+                              height > 1 ? (uint8_t)((255UL * y) / (height - 1)) : 0);
+      }
+    }
+  }
+
+  return returnValue;
+}
+
+Layout* Layout::ring(uint16_t numberOfLeds)
+{
+  Layout* returnValue = new Layout(numberOfLeds, 1, numberOfLeds);
+
+  for (uint16_t i = 0; i < numberOfLeds; i++)
+  {
+    returnValue->map(i, 0, i);
+
+    //
+    // Place each LED on a circle centered in the normalized
+    // space. This is only calculated once so floating point
+    // is not a concern.
+    //
+    double angle = (2.0 * PI * i) / numberOfLeds;
+    returnValue->position(i, (uint8_t)(127.5 + (127.5 * cos(angle))), (uint8_t)(127.5 + (127.5 * sin(angle))));
+  }
+
+  return returnValue;
+}
@@ -0,0 +1,123 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <FastLED.h>
+
+//
+// The value stored in the map for a logical position
+// that does not have an LED.
+//
+#define LAYOUT_NONE     0xFFFF
+
+//
+// The largest number of LEDs in a layout. The physical indexes
+// are 16 bits and LAYOUT_NONE is reserved, so the last LED is
+// at index 65534.
+//
+#define LAYOUT_MAXIMUM_LEDS   0xFFFF
+
+//
+// Describes the physical arrangement of the LEDs. The layout maps
+// a logical (x, y) position to the physical index of the LED in the
+// LED array and provides the normalized coordinates of each LED. The
+// tables are calculated once when the layout is created so that an
+// effect can draw in logical space with a single table lookup per
+// LED.
+//
+class Layout
+{
+  public:
+    Layout(uint16_t, uint16_t, uint16_t);
+    ~Layout();
+
+    //
+    // Creates the layout for a matrix of LEDs. When serpentine is
+    // true, every other row runs in the opposite direction (the
+    // common wiring for LED panels). Returns NULL if the matrix has
+    // more than LAYOUT_MAXIMUM_LEDS LEDs.
+    //
+    static Layout* matrix(uint16_t width, uint16_t height, bool serpentine);
+
+    //
+    // Creates the layout for a ring of LEDs. The logical space is
+    // a single row where x is the position around the ring.
+    //
+    static Layout* ring(uint16_t numberOfLeds);
+
+    //
+    // Returns the physical index of the LED at the logical
+    // position or -1 if there is no LED at that position.
+    //
+    inline int32_t index(int32_t x, int32_t y)
+    {
+      int32_t returnValue = -1;
+
+      if (x >= 0 && x < this->width && y >= 0 && y < this->height)
+      {
+        uint16_t i = this->_map[((uint32_t)y * this->width) + x];
+
+        if (i != LAYOUT_NONE)
+        {
+          returnValue = i;
+        }
+      }
+
+      return returnValue;
+    }
+
+    //
+    // Sets the physical index of the LED at a logical position.
+    // This can be used to build irregular layouts.
+    //
+    void map(uint16_t x, uint16_t y, uint16_t index);
+
+    //
+    // Sets the normalized coordinates of a physical LED.
+    //
+    void position(uint16_t index, uint8_t x, uint8_t y);
+
+    //
+    // The size of the logical space.
+    //
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    //
+    // The number of physical LEDs.
+    //
+    uint16_t numberOfLeds = 0;
+
+    //
+    // The normalized position, 0 to 255, of each physical LED
+    // in the logical space. These are indexed by physical index.
+    //
+    uint8_t* x;
+    uint8_t* y;
+
+  protected:
+    //
+    // Maps (y * width) + x to the physical index.
+    //
+    uint16_t* _map;
+};
+#endif
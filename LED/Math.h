@@ -21,12 +21,60 @@
 #ifndef MATH_H
 #define MATH_H
 
+//
+// The methods are defined inline so the compiler can avoid
+// a function call in the color conversions.
+//
 class Math
 {
     public:
-        static double Max(double a, double b);
-        static double Min(double a, double b);
-        static double Modulo(double a, double b);
-        static double Abs(double a);
+        static inline double Max(double a, double b)
+        {
+            double returnValue = a;
+
+            if (a > b)
+            {
+                returnValue = a;
+            }
+            else
+            {
+                returnValue = b;
+            }
+
+            return returnValue;
+        }
+
+        static inline double Min(double a, double b)
+        {
+            double returnValue = a;
+
+            if (a < b)
+            {
+                returnValue = a;
+            }
+            else
+            {
+                returnValue = b;
+            }
+
+            return returnValue;
+        }
+
+        static inline double Modulo(double a, double b)
+        {
+            return a - (b * ((int)(a / b)));
+        }
+
+        static inline double Abs(double a)
+        {
+            double returnValue = a;
+
+            if (a < 0)
+            {
+                returnValue = a * -1;
+            }
+
+            return returnValue;
+        }
 };
 #endif
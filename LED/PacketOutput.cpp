@@ -0,0 +1,132 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "PacketOutput.h"
+
+//
+// Initialize the output with an LED array, the number of LEDs
+// and the number of pixels sent in each packet.
+//
+PacketOutput::PacketOutput(CRGB *leds, uint32_t numberOfLeds, uint16_t pixelsPerPacket) : IOutput(leds, numberOfLeds)
+{
+  this->_pixelsPerPacket = pixelsPerPacket;
+
+  //
+  // Calculate the number of packets needed to send the
+  // entire LED array and allocate the change tracking.
+  //
+  this->_numberOfPackets = (numberOfLeds + pixelsPerPacket - 1) / pixelsPerPacket;
+  this->_sent = new CRGB[numberOfLeds];
+  this->_dirty = new bool[this->_numberOfPackets];
+
+  memset((void*)this->_sent, 0, numberOfLeds * sizeof(CRGB));
+  this->_lastRefresh = millis();
+  this->invalidate();
+};
+
+//
+// Deconstructor: release the change tracking.
+//
+PacketOutput::~PacketOutput()
+{
+  delete[] this->_sent;
+  delete[] this->_dirty;
+};
+
+//
+// Marks every packet as changed.
+//
+void PacketOutput::invalidate()
+{
+  for (uint32_t i = 0; i < this->_numberOfPackets; i++)
+  {
+    this->_dirty[i] = true;
+  }
+}
+
+bool PacketOutput::show()
+{
+  bool returnValue = false;
+
+  //
+  // Periodically send everything to recover from lost packets.
+  //
+  if ((unsigned long)(millis() - this->_lastRefresh) >= PACKET_REFRESH_INTERVAL)
+  {
+    this->_lastRefresh = millis();
+    this->invalidate();
+  }
+
+  //
+  // Find the packets that have changed since the last frame.
+  //
+  int64_t lastPacket = -1;
+
+  for (uint32_t i = 0; i < this->_numberOfPackets; i++)
+  {
+    if (this->changed(i))
+    {
+      this->_dirty[i] = true;
+    }
+
+    if (this->_dirty[i])
+    {
+      lastPacket = i;
+    }
+  }
+
+  //
+  // Send the changed packets.
+  //
+  for (int64_t i = 0; i <= lastPacket; i++)
+  {
+    if (this->_dirty[i])
+    {
+      if (this->sendPacket(i, i == lastPacket))
+      {
+        this->_dirty[i] = false;
+        returnValue = true;
+      }
+    }
+  }
+
+  return returnValue;
+}
+
+bool PacketOutput::refresh()
+{
+  return (unsigned long)(millis() - this->_lastRefresh) >= PACKET_REFRESH_INTERVAL ? this->show() : false;
+}
+
+bool PacketOutput::changed(uint32_t packet)
+{
+  CRGB* leds = &this->_leds[this->firstLed(packet)];
+  CRGB* sent = &this->_sent[this->firstLed(packet)];
+  size_t length = this->ledsInPacket(packet) * sizeof(CRGB);
+
+  bool returnValue = memcmp(leds, sent, length) != 0;
+
+  if (returnValue)
+  {
+    memcpy(sent, leds, length);
+  }
+
+  return returnValue;
+}
@@ -0,0 +1,97 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef PACKET_OUTPUT_H
+#define PACKET_OUTPUT_H
+
+#include "IOutput.h"
+
+//
+// Every this many ms all packets are sent even if they have not
+// changed. UDP does not guarantee delivery so this allows a
+// receiver to recover from a lost packet, and it keeps receivers
+// that blank after a timeout (2.5 s for E1.31) lit when the
+// effect draws slowly or not at all.
+//
+#define PACKET_REFRESH_INTERVAL   1000
+
+//
+// The base for outputs that send the LED array over the network in
+// packets of a fixed number of pixels (DDP packets, E1.31 universes).
+// Only the packets whose pixels have changed since the last frame are
+// sent; a change is detected by comparing each packet's pixels with a
+// copy of those last sent, which costs 3 bytes per LED.
+//
+class PacketOutput : public IOutput
+{
+  public:
+    PacketOutput(CRGB*, uint32_t, uint16_t);
+    ~PacketOutput();
+
+    //
+    // Sends each packet that has changed since the last frame.
+    //
+    bool show();
+
+    //
+    // Sends every packet when the refresh interval has passed
+    // since they were last all sent.
+    //
+    bool refresh();
+
+    //
+    // Marks every packet as changed so the entire LED
+    // array is sent on the next call to show().
+    //
+    void invalidate();
+
+  protected:
+    //
+    // Sends a single packet; last is true for the last packet
+    // sent in the frame.
+    //
+    virtual bool sendPacket(uint32_t packet, bool last) = 0;
+
+    //
+    // Returns the first LED and the number of LEDs in a packet.
+    //
+    inline uint32_t firstLed(uint32_t packet)
+    {
+      return packet * this->_pixelsPerPacket;
+    }
+
+    inline uint32_t ledsInPacket(uint32_t packet)
+    {
+      return min((uint32_t)this->_pixelsPerPacket, (uint32_t)(this->_numberOfLeds - this->firstLed(packet)));
+    }
+
+    //
+    // Compares the pixels of a packet with those last sent and
+    // records them; returns true if they have changed.
+    //
+    bool changed(uint32_t packet);
+
+    uint16_t _pixelsPerPacket = 1;
+    uint32_t _numberOfPackets = 0;
+    unsigned long _lastRefresh = 0;
+    CRGB* _sent;
+    bool* _dirty;
+};
+#endif
@@ -0,0 +1,222 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "IEffect.h"
+#include "FixedMath.h"
+
+//
+// This animation effect moves a pool of particles along the strip
+// adding the color of each particle to the LEDs it covers. The pool
+// is allocated once when the effect is created. Each property of the
+// particles is kept in its own array (structure of arrays) so that
+// the update loops are simple enough for the compiler to vectorize
+// on a host build.
+//
+// The default behavior emits sparks at random positions. Derive
+// from this effect and override onEmit() to create comets,
+// fireworks, etc.
+//
+class ParticleEffect : public IEffect
+{
+  public:
+    //
+    // Initializes the effect:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  frameLength:    Specifies the length of time, in ms, to display a single frame.
+    //  capacity:       Specifies the maximum number of particles.
+    //  emitRate:       Specifies the number of particles emitted each frame.
+    //  decay:          Specifies how much life (brightness) a particle loses each frame.
+    //  fade:           Specifies the amount of the previous frame that remains, 0 to 255,
+    //                  which creates trails behind the particles.
+    //
+    ParticleEffect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength, uint16_t capacity, uint8_t emitRate, uint8_t decay, uint8_t fade) : IEffect(leds, numberOfLeds, frameLength)
+    {
+      this->_capacity = capacity;
+      this->_emitRate = emitRate;
+      this->_decay = decay;
+      this->_fade = fade;
+
+      this->_position = new int32_t[capacity];
+      this->_velocity = new int16_t[capacity];
+      this->_life = new uint8_t[capacity];
+      this->_hue = new uint8_t[capacity];
+    }
+
+    ~ParticleEffect()
+    {
+      delete[] this->_position;
+      delete[] this->_velocity;
+      delete[] this->_life;
+      delete[] this->_hue;
+    }
+
+    //
+    // Resets this animation effect by removing all of the
+    // particles and then calls the base implementation.
+    //
+    bool reset()
+    {
+      this->_count = 0;
+
+      //
+      // Call the base reset.
+      //
+      return IEffect::reset();
+    }
+
+    //
+    // Adds a particle. Positions and velocities are 8.8 fixed-point
+    // in LEDs (256 is one LED) and velocity is per frame. Returns
+    // false if the pool is full.
+    //
+    bool emit(int32_t position, int16_t velocity, uint8_t life, uint8_t hue)
+    {
+      bool returnValue = false;
+
+      if (this->_count < this->_capacity)
+      {
+        this->_position[this->_count] = position;
+        this->_velocity[this->_count] = velocity;
+        this->_life[this->_count] = life;
+        this->_hue[this->_count] = hue;
+        this->_count++;
+        returnValue = true;
+      }
+
+      return returnValue;
+    }
+
+  protected:
+    //
+    // Emits the new particles for a frame. The default
+    // implementation emits sparks at random positions.
+    //
+    virtual void onEmit()
+    {
+      for (uint8_t i = 0; i < this->_emitRate; i++)
+      {
+        int32_t position = (int32_t)random16((uint16_t)this->_numberOfLeds) << 8;
+        int16_t velocity = (int16_t)random8() - 128;
+        this->emit(position, velocity, 255, random8());
+      }
+    }
+
+    bool onAnimate()
+    {
+      //
+      // Move the particles and age them. These loops have no
+      // branches or dependencies between particles.
+      //
+      int32_t* position = this->_position;
+      int16_t* velocity = this->_velocity;
+      uint8_t* life = this->_life;
+      uint8_t decay = this->_decay;
+      uint16_t count = this->_count;
+
+      for (uint16_t i = 0; i < count; i++)
+      {
+        position[i] += velocity[i];
+      }
+
+      for (uint16_t i = 0; i < count; i++)
+      {
+        life[i] = FixedMath::QSub8(life[i], decay);
+      }
+
+      //
+      // Remove particles that have died or left the strip by
+      // moving the last particle into their place.
+      //
+      int32_t end = (int32_t)this->_numberOfLeds << 8;
+      uint16_t i = 0;
+
+      while (i < this->_count)
+      {
+        if (this->_life[i] == 0 || this->_position[i] < 0 || this->_position[i] >= end)
+        {
+          this->_count--;
+          this->_position[i] = this->_position[this->_count];
+          this->_velocity[i] = this->_velocity[this->_count];
+          this->_life[i] = this->_life[this->_count];
+          this->_hue[i] = this->_hue[this->_count];
+        }
+        else
+        {
+          i++;
+        }
+      }
+
+      this->onEmit();
+
+      //
+      // Fade the previous frame.
+      //
+      for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+      {
+        this->_leds[i].nscale8(this->_fade);
+      }
+
+      //
+      // Add each particle to the two LEDs it lies between in
+      // proportion to how close it is to each of them.
+      //
+      for (uint16_t i = 0; i < this->_count; i++)
+      {
+        int64_t index = this->_position[i] >> 8;
+        uint8_t fraction = (uint8_t)this->_position[i];
+        CRGB rgb = CHSV(this->_hue[i], 255, this->_life[i]);
+
+        this->addLed(index, CRGB(rgb).nscale8(255 - fraction));
+        this->addLed(index + 1, rgb.nscale8(fraction));
+      }
+
+      //
+      // Return true since the animation was changed.
+      //
+      return true;
+    }
+
+    //
+    // Adds a color to an LED (saturating at full brightness)
+    // ensuring the index is within the range of LEDs.
+    //
+    inline void addLed(int64_t index, CRGB rgb)
+    {
+      if (index >= 0 && (uint64_t)index < this->_numberOfLeds)
+      {
+        this->_leds[index] += rgb;
+      }
+    }
+
+    uint16_t _count = 0;
+    uint16_t _capacity = 0;
+    uint8_t _emitRate = 1;
+    uint8_t _decay = 8;
+    uint8_t _fade = 128;
+
+    //
+    // The particles.
+    //
+    int32_t* _position;
+    int16_t* _velocity;
+    uint8_t* _life;
+    uint8_t* _hue;
+};
@@ -0,0 +1,209 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Persistence.h"
+
+//
+// Initialize the persistence with the first EEPROM address
+// and the number of slots.
+//
+Persistence::Persistence(uint16_t address, uint8_t numberOfSlots)
+{
+  this->_address = address;
+
+  if (numberOfSlots == PERSISTENCE_ALL_SLOTS)
+  {
+    uint16_t available = PERSISTENCE_EEPROM_LENGTH > address ? (PERSISTENCE_EEPROM_LENGTH - address) / PERSISTENCE_SLOT_LENGTH : 0;
+    numberOfSlots = (uint8_t)min(available, (uint16_t)255);
+  }
+
+  this->_numberOfSlots = numberOfSlots > 0 ? numberOfSlots : 1;
+};
+
+uint16_t Persistence::length()
+{
+  return (uint16_t)this->_numberOfSlots * PERSISTENCE_SLOT_LENGTH;
+}
+
+bool Persistence::restore(IEffect **effects, uint8_t numberOfEffects, int *effect)
+{
+  bool returnValue = false;
+  bool found = false;
+
+#if defined(ESP8266) || defined(ESP32)
+  //
+  // These boards emulate EEPROM in flash and must be
+  // told how much of it to use.
+  //
+  EEPROM.begin(max(PERSISTENCE_EEPROM_LENGTH, this->_address + this->length()));
+#endif
+
+  uint8_t latest[PERSISTENCE_SLOT_LENGTH];
+  uint8_t buffer[PERSISTENCE_SLOT_LENGTH];
+
+  //
+  // Find the slot with the highest sequence number. The
+  // comparison allows the sequence number to wrap around.
+  //
+  for (uint8_t i = 0; i < this->_numberOfSlots; i++)
+  {
+    if (this->read(i, buffer))
+    {
+      uint16_t sequence = (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+
+      if (!found || (int16_t)(sequence - this->_sequence) > 0)
+      {
+        found = true;
+        this->_slot = i;
+        this->_sequence = sequence;
+        memcpy(latest, buffer, PERSISTENCE_SLOT_LENGTH);
+      }
+    }
+  }
+
+  if (found)
+  {
+    uint8_t saved = latest[2];
+    uint8_t length = latest[3];
+
+    if (saved < numberOfEffects)
+    {
+      effects[saved]->reset();
+
+      if (effects[saved]->restoreState(&latest[4], length))
+      {
+        *effect = saved;
+        memcpy(this->_last, &latest[2], sizeof(this->_last));
+        this->_written = true;
+        returnValue = true;
+      }
+    }
+  }
+
+  this->_saveTime = millis();
+
+  return returnValue;
+}
+
+void Persistence::changed()
+{
+  this->_pending = true;
+  this->_changeTime = millis();
+}
+
+bool Persistence::update(uint8_t effect, IEffect *instance)
+{
+  bool returnValue = false;
+  uint64_t now = millis();
+
+  if ((this->_pending && (now - this->_changeTime) >= PERSISTENCE_DEBOUNCE) || (now - this->_saveTime) >= PERSISTENCE_INTERVAL)
+  {
+    //
+    // The snapshot is the effect, the length of its
+    // state and the state.
+    //
+    uint8_t snapshot[2 + EFFECT_STATE_LENGTH];
+    memset(snapshot, 0, sizeof(snapshot));
+    snapshot[0] = effect;
+    snapshot[1] = instance->saveState(&snapshot[2]);
+
+    //
+    // Only write the snapshot if it is different from the
+    // last one written.
+    //
+    if (!this->_written || memcmp(snapshot, this->_last, sizeof(snapshot)) != 0)
+    {
+      this->write(effect, &snapshot[2], snapshot[1]);
+      memcpy(this->_last, snapshot, sizeof(snapshot));
+      this->_written = true;
+      returnValue = true;
+    }
+
+    this->_pending = false;
+    this->_saveTime = now;
+  }
+
+  return returnValue;
+}
+
+void Persistence::write(uint8_t effect, const uint8_t *state, uint8_t length)
+{
+  uint8_t buffer[PERSISTENCE_SLOT_LENGTH];
+
+  this->_slot = (this->_slot + 1) % this->_numberOfSlots;
+  this->_sequence++;
+
+  buffer[0] = (uint8_t)this->_sequence;
+  buffer[1] = (uint8_t)(this->_sequence >> 8);
+  buffer[2] = effect;
+  buffer[3] = length;
+  memcpy(&buffer[4], state, EFFECT_STATE_LENGTH);
+  buffer[PERSISTENCE_SLOT_LENGTH - 1] = Persistence::crc(buffer, PERSISTENCE_SLOT_LENGTH - 1);
+
+  //
+  // update() only writes the bytes that have changed.
+  //
+  uint16_t address = this->_address + ((uint16_t)this->_slot * PERSISTENCE_SLOT_LENGTH);
+
+  for (uint8_t i = 0; i < PERSISTENCE_SLOT_LENGTH; i++)
+  {
+#if defined(ESP8266) || defined(ESP32)
+    EEPROM.write(address + i, buffer[i]);
+#else
+    EEPROM.update(address + i, buffer[i]);
+#endif
+  }
+
+#if defined(ESP8266) || defined(ESP32)
+  EEPROM.commit();
+#endif
+}
+
+bool Persistence::read(uint8_t slot, uint8_t *buffer)
+{
+  uint16_t address = this->_address + ((uint16_t)slot * PERSISTENCE_SLOT_LENGTH);
+
+  for (uint8_t i = 0; i < PERSISTENCE_SLOT_LENGTH; i++)
+  {
+    buffer[i] = EEPROM.read(address + i);
+  }
+
+  return buffer[3] <= EFFECT_STATE_LENGTH && Persistence::crc(buffer, PERSISTENCE_SLOT_LENGTH - 1) == buffer[PERSISTENCE_SLOT_LENGTH - 1];
+}
+
+//
+// CRC-8 (polynomial 0x07).
+//
+uint8_t Persistence::crc(const uint8_t *data, uint8_t length)
+{
+  uint8_t crc = 0;
+
+  for (uint8_t i = 0; i < length; i++)
+  {
+    crc ^= data[i];
+
+    for (uint8_t b = 0; b < 8; b++)
+    {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+
+  return crc;
+}
@@ -0,0 +1,137 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include "IEffect.h"
+#include <EEPROM.h>
+
+//
+// The size of a saved snapshot: sequence (2), effect (1),
+// length (1), state and a CRC (1).
+//
+#define PERSISTENCE_SLOT_LENGTH   (5 + EFFECT_STATE_LENGTH)
+
+//
+// How long, in ms, to wait after a change before saving it so
+// that a burst of changes results in a single write.
+//
+#define PERSISTENCE_DEBOUNCE      2000
+
+//
+// How often, in ms, the animation state of the running effect
+// is saved (only if it has changed). A running effect changes on
+// every save so this, with the number of slots, sets the wear:
+// with 35 slots (1 KB of EEPROM) each slot is written every
+// 175 minutes and lasts over 30 years.
+//
+#define PERSISTENCE_INTERVAL      300000
+
+//
+// Pass as the number of slots to use all of the EEPROM
+// after the first address.
+//
+#define PERSISTENCE_ALL_SLOTS     0
+
+//
+// Boards that emulate EEPROM in flash are told how much to
+// use; elsewhere it is the size of the EEPROM.
+//
+#if defined(ESP8266) || defined(ESP32)
+#define PERSISTENCE_EEPROM_LENGTH 512
+#else
+#define PERSISTENCE_EEPROM_LENGTH EEPROM.length()
+#endif
+
+//
+// Saves the current effect and its state to EEPROM so the
+// sketch can continue where it left off after a power loss.
+//
+// EEPROM cells wear out after roughly 100,000 writes so the
+// snapshots are written to a ring of slots, each with a sequence
+// number; the slot with the highest valid sequence number is the
+// latest. Writes are debounced and only bytes that have changed
+// are written.
+//
+class Persistence
+{
+  public:
+    //
+    // Initializes the persistence:
+    //  address:        The first EEPROM address to use.
+    //  numberOfSlots:  The number of slots in the ring or PERSISTENCE_ALL_SLOTS.
+    //
+    Persistence(uint16_t, uint8_t);
+
+    //
+    // Restores the latest snapshot: resets the saved effect and
+    // restores its state. Returns false, leaving effect unchanged,
+    // if there is no valid snapshot.
+    //
+    bool restore(IEffect** effects, uint8_t numberOfEffects, int* effect);
+
+    //
+    // Indicates the effect or its parameters have changed; the
+    // snapshot is saved once the changes stop.
+    //
+    void changed();
+
+    //
+    // Saves a snapshot of the effect when a change is pending or
+    // the save interval has elapsed. Call this from loop().
+    //
+    bool update(uint8_t effect, IEffect* instance);
+
+    //
+    // Returns the number of bytes of EEPROM used.
+    //
+    uint16_t length();
+
+  protected:
+    //
+    // Writes the snapshot to the next slot.
+    //
+    void write(uint8_t effect, const uint8_t* state, uint8_t length);
+
+    //
+    // Reads a slot returning false if its CRC is not valid.
+    //
+    bool read(uint8_t slot, uint8_t* buffer);
+
+    static uint8_t crc(const uint8_t* data, uint8_t length);
+
+    uint16_t _address = 0;
+    uint8_t _numberOfSlots = 1;
+    uint8_t _slot = 0;
+    uint16_t _sequence = 0;
+
+    bool _pending = false;
+    uint64_t _changeTime = 0;
+    uint64_t _saveTime = 0;
+
+    //
+    // The last snapshot written (or restored) used to skip
+    // writing a snapshot that has not changed.
+    //
+    uint8_t _last[2 + EFFECT_STATE_LENGTH];
+    bool _written = false;
+};
+#endif
@@ -0,0 +1,171 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "IEffect.h"
+#include "Effect.h"
+#include "FixedMath.h"
+
+//
+// This animation effect fills the strip with a moving plasma
+// created from two sine waves travelling in opposite directions
+// mixed with gradient noise. All of the math is integer so every
+// LED can be calculated on every frame, even on an 8-bit
+// microcontroller.
+//
+class PlasmaEffect : public IEffect
+{
+  public:
+    //
+    // Initializes the effect:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  frameLength:    Specifies the length of time, in ms, to display a single frame.
+    //  scale:          Specifies the size of the features; larger values
+    //                  make the waves shorter.
+    //
+    PlasmaEffect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength, uint8_t scale) : IEffect(leds, numberOfLeds, frameLength)
+    {
+      this->_scale = scale;
+    }
+
+    //
+    // Resets this animation effect by setting the frame
+    // back to 0 and then calls the base implementation.
+    //
+    bool reset()
+    {
+      this->_frame = 0;
+
+      //
+      // Call the base reset.
+      //
+      return IEffect::reset();
+    }
+
+    //
+    // Moves to the plasma drawn at the specified frame.
+    //
+    void seekFrame(uint64_t frame)
+    {
+      this->_frame = (uint16_t)frame;
+    }
+
+    //
+    // Draws the plasma for the specified frame. StaticPlasmaEffect
+    // draws with this as well.
+    //
+    static inline void draw(CRGB *leds, uint64_t numberOfLeds, uint16_t frame, uint8_t scale)
+    {
+      uint8_t t = (uint8_t)frame;
+      uint16_t position = 0;
+
+      for (uint64_t i = 0; i < numberOfLeds; i++)
+      {
+        //
+        // Combine the two waves and the noise into a hue. The sum
+        // wraps around the color wheel which is what is wanted.
+        //
+        uint8_t hue = (uint8_t)(FixedMath::Sin8((uint8_t)(position >> 8) + t) +
+                                FixedMath::Sin8((uint8_t)(position >> 7) - (uint8_t)(t << 1)) +
+                                FixedMath::Noise8(position, frame << 3));
+
+        //
+        // Use the noise again at a different position for the
+        // brightness so the plasma has darker patches.
+        //
+        uint8_t value = FixedMath::QAdd8(FixedMath::Noise8(position + 0x8000, frame << 2), 64);
+
+        leds[i] = CHSV(hue, 255, value);
+
+        position += scale << 4;
+      }
+    }
+
+  protected:
+    bool onAnimate()
+    {
+      PlasmaEffect::draw(this->_leds, this->_numberOfLeds, this->_frame, this->_scale);
+
+      //
+      // Increment the frame counter.
+      //
+      this->_frame++;
+
+      //
+      // Return true since the animation was changed.
+      //
+      return true;
+    }
+
+  private:
+    uint16_t _frame = 0;
+    uint8_t _scale = 16;
+};
+
+//
+// PlasmaEffect for an EffectSet: the same plasma drawn through
+// Effect<T>, so the frame timing and the drawing loop are inlined
+// into EffectSet::animate() rather than called through a vtable.
+//
+class StaticPlasmaEffect : public Effect<StaticPlasmaEffect>
+{
+  friend class Effect<StaticPlasmaEffect>;
+
+  public:
+    //
+    // Initializes the effect (see PlasmaEffect).
+    //
+    StaticPlasmaEffect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength, uint8_t scale) : Effect<StaticPlasmaEffect>(leds, numberOfLeds, frameLength)
+    {
+      this->_scale = scale;
+    }
+
+    //
+    // Resets this animation effect by setting the frame
+    // back to 0 and then calls the base implementation.
+    //
+    inline bool reset()
+    {
+      this->_frame = 0;
+
+      //
+      // Call the base reset.
+      //
+      return Effect<StaticPlasmaEffect>::reset();
+    }
+
+    inline void seekFrame(uint64_t frame)
+    {
+      this->_frame = (uint16_t)frame;
+    }
+
+  protected:
+    inline bool onAnimate()
+    {
+      PlasmaEffect::draw(this->_leds, this->_numberOfLeds, this->_frame, this->_scale);
+      this->_frame++;
+
+      return true;
+    }
+
+  private:
+    uint16_t _frame = 0;
+    uint8_t _scale = 16;
+};
@@ -0,0 +1,263 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "RenderEngine.h"
+
+#ifndef ARDUINO
+#include <cstdlib>
+#include <cstring>
+#endif
+
+//
+// Initialize the engine using one thread per core.
+//
+RenderEngine::RenderEngine(uint16_t maximumStrips) : RenderEngine(maximumStrips, 0)
+{
+};
+
+//
+// Initialize the engine with the maximum number of strips
+// and the number of threads used to animate them.
+//
+RenderEngine::RenderEngine(uint16_t maximumStrips, uint16_t numberOfThreads)
+{
+  this->_maximumStrips = maximumStrips;
+  this->_strips = new Strip[maximumStrips];
+
+#ifndef ARDUINO
+  //
+  // Default to one thread per core.
+  //
+  if (numberOfThreads == 0)
+  {
+    numberOfThreads = std::thread::hardware_concurrency();
+  }
+
+  this->_numberOfThreads = numberOfThreads > 0 ? numberOfThreads : 1;
+  this->_queues = new Queue[this->_numberOfThreads];
+
+  //
+  // The thread calling render() does the work of the first
+  // queue so one less thread is started.
+  //
+  this->_threads = new std::thread[this->_numberOfThreads - 1];
+
+  for (uint16_t i = 1; i < this->_numberOfThreads; i++)
+  {
+    this->_threads[i - 1] = std::thread(&RenderEngine::run, this, i);
+  }
+#endif
+};
+
+//
+// Deconstructor: stop the threads and release the strips.
+//
+RenderEngine::~RenderEngine()
+{
+#ifndef ARDUINO
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_stop = true;
+  }
+
+  this->_start.notify_all();
+
+  for (uint16_t i = 1; i < this->_numberOfThreads; i++)
+  {
+    this->_threads[i - 1].join();
+  }
+
+  delete[] this->_threads;
+  delete[] this->_queues;
+#endif
+
+  delete[] this->_strips;
+};
+
+bool RenderEngine::add(IEffect *effect, IOutput *output)
+{
+  bool returnValue = false;
+
+  if (this->_numberOfStrips < this->_maximumStrips)
+  {
+    Strip& strip = this->_strips[this->_numberOfStrips++];
+    strip.effect = effect;
+    strip.output = output;
+    strip.changed = false;
+    returnValue = true;
+  }
+
+  return returnValue;
+}
+
+void RenderEngine::reset()
+{
+  for (uint16_t i = 0; i < this->_numberOfStrips; i++)
+  {
+    this->_strips[i].effect->reset();
+  }
+}
+
+uint16_t RenderEngine::render()
+{
+#ifndef ARDUINO
+  if (this->_numberOfThreads > 1)
+  {
+    //
+    // Divide the strips evenly between the queues. The queues
+    // are set before the generation changes so the threads see
+    // them when they wake.
+    //
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+
+      for (uint16_t i = 0; i < this->_numberOfThreads; i++)
+      {
+        this->_queues[i].next.store(((uint32_t)this->_numberOfStrips * i) / this->_numberOfThreads, std::memory_order_relaxed);
+        this->_queues[i].end = ((uint32_t)this->_numberOfStrips * (i + 1)) / this->_numberOfThreads;
+      }
+
+      this->_running = this->_numberOfThreads - 1;
+      this->_generation++;
+    }
+
+    this->_start.notify_all();
+
+    //
+    // Work on the first queue and then wait for the
+    // other threads to finish (the frame barrier).
+    //
+    this->work(0);
+
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_finished.wait(lock, [this] { return this->_running == 0; });
+  }
+  else
+#endif
+  {
+    for (uint16_t i = 0; i < this->_numberOfStrips; i++)
+    {
+      this->_strips[i].changed = this->_strips[i].effect->animate();
+    }
+  }
+
+  //
+  // Every strip has finished the frame; show the ones that
+  // changed. Outputs are shown in order from a single thread.
+  //
+  uint16_t returnValue = 0;
+
+  for (uint16_t i = 0; i < this->_numberOfStrips; i++)
+  {
+    if (this->_strips[i].changed)
+    {
+      this->_strips[i].output->show();
+      returnValue++;
+    }
+  }
+
+  return returnValue;
+}
+
+#ifndef ARDUINO
+void RenderEngine::work(uint16_t thread)
+{
+  //
+  // Start with this thread's own queue and then move through
+  // the other queues stealing any strips that remain.
+  //
+  for (uint16_t i = 0; i < this->_numberOfThreads; i++)
+  {
+    Queue& queue = this->_queues[(thread + i) % this->_numberOfThreads];
+
+    while (true)
+    {
+      uint32_t next = queue.next.fetch_add(1, std::memory_order_relaxed);
+
+      if (next >= queue.end)
+      {
+        break;
+      }
+
+      this->_strips[next].changed = this->_strips[next].effect->animate();
+    }
+  }
+}
+
+void RenderEngine::run(uint16_t thread)
+{
+  uint64_t generation = 0;
+
+  while (true)
+  {
+    //
+    // Wait for the next frame.
+    //
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_start.wait(lock, [this, generation] { return this->_stop || this->_generation != generation; });
+
+      if (this->_stop)
+      {
+        break;
+      }
+
+      generation = this->_generation;
+    }
+
+    this->work(thread);
+
+    //
+    // Signal the frame barrier.
+    //
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      this->_running--;
+
+      if (this->_running == 0)
+      {
+        this->_finished.notify_one();
+      }
+    }
+  }
+}
+#endif
+
+CRGB* RenderEngine::createLeds(uint32_t numberOfLeds)
+{
+#ifndef ARDUINO
+  size_t size = (((numberOfLeds * sizeof(CRGB)) + RENDER_CACHE_LINE - 1) / RENDER_CACHE_LINE) * RENDER_CACHE_LINE;
+  size = size > 0 ? size : RENDER_CACHE_LINE;
+  CRGB* returnValue = (CRGB*)std::aligned_alloc(RENDER_CACHE_LINE, size);
+  std::memset((void*)returnValue, 0, size);
+  return returnValue;
+#else
+  return new CRGB[numberOfLeds];
+#endif
+}
+
+void RenderEngine::destroyLeds(CRGB *leds)
+{
+#ifndef ARDUINO
+  std::free(leds);
+#else
+  delete[] leds;
+#endif
+}
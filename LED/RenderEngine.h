@@ -0,0 +1,151 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef RENDER_ENGINE_H
+#define RENDER_ENGINE_H
+
+#include "IEffect.h"
+#include "IOutput.h"
+
+#ifndef ARDUINO
+//
+// The strips and queues are aligned with alignas() and allocated
+// with new[], and the LED arrays with std::aligned_alloc; both
+// need C++17.
+//
+#if __cplusplus < 201703L
+#error "RenderEngine needs C++17 on the host (-std=c++17)."
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+//
+// The size of a cache line. Per-strip data written by the render
+// threads is aligned to this so that two threads never write to
+// the same cache line (false sharing). On a microcontroller there
+// is no cache and no threads so nothing is aligned.
+//
+#ifndef ARDUINO
+#define RENDER_CACHE_LINE   64
+#define RENDER_ALIGNED      alignas(RENDER_CACHE_LINE)
+#else
+#define RENDER_CACHE_LINE   1
+#define RENDER_ALIGNED
+#endif
+
+//
+// Renders many independent strips, each driven by its own effect
+// and output. Each call to render() animates every strip and then,
+// once all of the strips have finished the frame, shows the strips
+// that changed.
+//
+// On a host build the effects are animated in parallel by a pool
+// of threads. The strips are divided evenly between the threads
+// and a thread that finishes its own strips steals strips from the
+// others. On a microcontroller the strips are animated in order.
+//
+class RenderEngine
+{
+  public:
+    //
+    // Initializes the engine:
+    //  maximumStrips:      The maximum number of strips that can be added.
+    //  numberOfThreads:    The number of threads used to animate (host only). The
+    //                      default is the number of cores.
+    //
+    RenderEngine(uint16_t);
+    RenderEngine(uint16_t, uint16_t);
+    ~RenderEngine();
+
+    //
+    // Adds a strip. Returns false if the engine is full.
+    //
+    bool add(IEffect* effect, IOutput* output);
+
+    //
+    // Resets the effect on every strip.
+    //
+    void reset();
+
+    //
+    // Animates a single frame on every strip and then shows the
+    // strips that changed. Returns the number of strips shown.
+    //
+    uint16_t render();
+
+    //
+    // Allocates an LED array aligned to, and padded to a multiple
+    // of, the cache line size so that the arrays of two strips
+    // never share a cache line. Release it with destroyLeds().
+    //
+    static CRGB* createLeds(uint32_t numberOfLeds);
+    static void destroyLeds(CRGB* leds);
+
+  protected:
+    struct RENDER_ALIGNED Strip
+    {
+      IEffect* effect;
+      IOutput* output;
+      bool changed;
+    };
+
+    Strip* _strips;
+    uint16_t _numberOfStrips = 0;
+    uint16_t _maximumStrips = 0;
+
+#ifndef ARDUINO
+    //
+    // The strips waiting to be animated by a thread. Other
+    // threads steal from the queue by advancing next.
+    //
+    struct RENDER_ALIGNED Queue
+    {
+      std::atomic<uint32_t> next;
+      uint32_t end;
+    };
+
+    //
+    // Animates the strips of the specified thread's queue and then
+    // steals from the other queues until all of them are empty.
+    //
+    void work(uint16_t thread);
+
+    //
+    // The body of each pool thread.
+    //
+    void run(uint16_t thread);
+
+    Queue* _queues;
+    std::thread* _threads;
+    uint16_t _numberOfThreads = 1;
+
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _finished;
+    uint64_t _generation = 0;
+    uint16_t _running = 0;
+    bool _stop = false;
+#endif
+};
+#endif
@@ -0,0 +1,233 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Sequencer.h"
+#include "Clock.h"
+
+//
+// Initialize the sequencer with the effects and the show.
+//
+Sequencer::Sequencer(IEffect **effects, uint8_t numberOfEffects, const uint8_t *show)
+{
+  this->_effects = effects;
+  this->_numberOfEffects = numberOfEffects;
+  this->_show = show;
+
+  if (this->valid())
+  {
+    this->numberOfCues = this->readUInt16(3);
+  }
+};
+
+bool Sequencer::valid()
+{
+  return this->readByte(0) == CUE_MAGIC_1 && this->readByte(1) == CUE_MAGIC_2 && this->readByte(2) == CUE_VERSION;
+}
+
+bool Sequencer::start()
+{
+  this->_brightness = FastLED.getBrightness();
+  return this->seek(0);
+}
+
+bool Sequencer::seek(uint16_t cue)
+{
+  return this->load(cue, 0);
+}
+
+bool Sequencer::seekTime(uint32_t time)
+{
+  bool returnValue = false;
+
+  if (this->numberOfCues > 0)
+  {
+    //
+    // The cues are in order of their start time so a binary
+    // search finds the last cue starting at or before the time.
+    //
+    uint16_t low = 0;
+    uint16_t high = this->numberOfCues - 1;
+
+    while (low < high)
+    {
+      uint16_t middle = low + ((high - low + 1) / 2);
+
+      if (this->readUInt32(CUE_HEADER_LENGTH + ((uint32_t)middle * CUE_LENGTH)) <= time)
+      {
+        low = middle;
+      }
+      else
+      {
+        high = middle - 1;
+      }
+    }
+
+    uint32_t record = CUE_HEADER_LENGTH + ((uint32_t)low * CUE_LENGTH);
+    uint32_t start = this->readUInt32(record);
+    uint32_t offset = time > start ? time - start : 0;
+
+    if (offset < this->readUInt32(record + 4))
+    {
+      returnValue = this->load(low, offset);
+    }
+  }
+
+  return returnValue;
+}
+
+bool Sequencer::load(uint16_t cue, uint32_t offset)
+{
+  bool returnValue = false;
+
+  if (cue < this->numberOfCues)
+  {
+    uint32_t record = CUE_HEADER_LENGTH + ((uint32_t)cue * CUE_LENGTH);
+    uint8_t effect = this->readByte(record + 8);
+
+    if (effect < this->_numberOfEffects)
+    {
+      this->restore();
+      this->cue = cue;
+      this->_effect = this->_effects[effect];
+      this->_duration = this->readUInt32(record + 4);
+      this->_transition = this->readByte(record + 9);
+      this->_transitionLength = this->readUInt16(record + 10);
+
+      //
+      // Set the parameters before the reset so the
+      // effect starts with them.
+      //
+      uint8_t parameter1 = this->readByte(record + 12);
+      uint8_t parameter2 = this->readByte(record + 13);
+
+      if (parameter1 != CUE_NONE || parameter2 != CUE_NONE)
+      {
+        this->_changed = this->_effect;
+        this->_stateLength = this->_effect->saveState(this->_state);
+      }
+
+      if (parameter1 != CUE_NONE)
+      {
+        this->_effect->setParameter(parameter1, this->readUInt32(record + 14));
+      }
+
+      if (parameter2 != CUE_NONE)
+      {
+        this->_effect->setParameter(parameter2, this->readUInt32(record + 18));
+      }
+
+      this->_effect->reset();
+      this->_cueStart = Clock::now() - offset;
+      this->playing = true;
+      returnValue = true;
+    }
+  }
+
+  return returnValue;
+}
+
+void Sequencer::restore()
+{
+  if (this->_changed != NULL)
+  {
+    this->_changed->restoreState(this->_state, this->_stateLength);
+    this->_changed = NULL;
+  }
+}
+
+bool Sequencer::animate()
+{
+  bool returnValue = false;
+
+  if (this->playing)
+  {
+    uint64_t elapsed = Clock::now() - this->_cueStart;
+
+    //
+    // Move to the next cue when the current one has ended. The next
+    // cue starts when the current one ended, not now, so the time
+    // loop() was late by is not added to the length of the show.
+    //
+    if (elapsed >= this->_duration)
+    {
+      uint16_t next = this->cue + 1;
+      uint32_t late = (uint32_t)(elapsed - this->_duration);
+
+      if (next >= this->numberOfCues)
+      {
+        next = 0;
+        this->playing = this->loop;
+      }
+
+      if (!this->playing || !this->load(next, late))
+      {
+        this->playing = false;
+        this->restore();
+        FastLED.setBrightness(this->_brightness);
+        return false;
+      }
+
+      elapsed = late;
+    }
+
+    //
+    // Fade in from black over the length of the transition.
+    //
+    if (this->_transition == CUE_FADE && this->_transitionLength > 0)
+    {
+      uint8_t brightness = this->_brightness;
+
+      if (elapsed < this->_transitionLength)
+      {
+        brightness = (uint8_t)((elapsed * this->_brightness) / this->_transitionLength);
+      }
+
+      if (brightness != FastLED.getBrightness())
+      {
+        FastLED.setBrightness(brightness);
+        returnValue = true;
+      }
+    }
+    else if (FastLED.getBrightness() != this->_brightness)
+    {
+      FastLED.setBrightness(this->_brightness);
+      returnValue = true;
+    }
+
+    returnValue = this->_effect->animate() || returnValue;
+  }
+
+  return returnValue;
+}
+
+uint8_t Sequencer::readByte(uint32_t offset)
+{
+  return pgm_read_byte(this->_show + offset);
+}
+
+uint16_t Sequencer::readUInt16(uint32_t offset)
+{
+  return (uint16_t)this->readByte(offset) | ((uint16_t)this->readByte(offset + 1) << 8);
+}
+
+uint32_t Sequencer::readUInt32(uint32_t offset)
+{
+  return (uint32_t)this->readUInt16(offset) | ((uint32_t)this->readUInt16(offset + 2) << 16);
+}
@@ -0,0 +1,140 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+#include "IEffect.h"
+#include "Cue.h"
+
+//
+// Plays a show: a compiled list of cues stored in flash (see Cue.h).
+// Each cue selects an effect, sets up to two of its parameters and
+// runs it for a length of time. The parameters only last for the
+// cue: the effect gets its own back when the cue ends or the show
+// stops. The show is read directly from
+// flash so it uses no RAM and the work done each frame does not
+// depend on the length of the show.
+//
+class Sequencer
+{
+  public:
+    //
+    // Initializes the sequencer:
+    //  effects:            The effects the cues refer to by index.
+    //  numberOfEffects:    The number of effects.
+    //  show:               The compiled show (in flash).
+    //
+    Sequencer(IEffect**, uint8_t, const uint8_t*);
+
+    //
+    // Returns false if the show is not a valid compiled show.
+    //
+    bool valid();
+
+    //
+    // Starts the show from the first cue.
+    //
+    bool start();
+
+    //
+    // Jumps to the start of a cue.
+    //
+    bool seek(uint16_t cue);
+
+    //
+    // Jumps to a time, in ms, from the start of the show. Returns
+    // false if the time is past the end of the show.
+    //
+    bool seekTime(uint32_t time);
+
+    //
+    // Advances to the next cue when the current cue has ended,
+    // applies the transition and animates the current effect.
+    // Call this from loop(); returns true if the LEDs changed.
+    //
+    bool animate();
+
+    //
+    // The number of cues in the show.
+    //
+    uint16_t numberOfCues = 0;
+
+    //
+    // The index of the current cue.
+    //
+    uint16_t cue = 0;
+
+    //
+    // When true the show starts over after the last cue;
+    // otherwise it stops.
+    //
+    bool loop = true;
+
+    //
+    // True while the show is playing.
+    //
+    bool playing = false;
+
+  protected:
+    //
+    // Loads a cue and starts it as if offset ms had already
+    // elapsed.
+    //
+    bool load(uint16_t cue, uint32_t offset);
+
+    //
+    // Gives the effect of the last cue back the parameters
+    // it had before the cue changed them.
+    //
+    void restore();
+
+    uint8_t readByte(uint32_t offset);
+    uint16_t readUInt16(uint32_t offset);
+    uint32_t readUInt32(uint32_t offset);
+
+    IEffect** _effects;
+    uint8_t _numberOfEffects = 0;
+    const uint8_t* _show;
+
+    //
+    // The current cue.
+    //
+    IEffect* _effect = NULL;
+    uint64_t _cueStart = 0;
+    uint32_t _duration = 0;
+    uint8_t _transition = CUE_CUT;
+    uint16_t _transitionLength = 0;
+
+    //
+    // The state of the effect whose parameters the current
+    // cue changed, saved before the change.
+    //
+    IEffect* _changed = NULL;
+    uint8_t _state[EFFECT_STATE_LENGTH];
+    uint8_t _stateLength = 0;
+
+    //
+    // The brightness the show was started with; fades
+    // ramp up to it.
+    //
+    uint8_t _brightness = 255;
+};
+#endif
@@ -39,13 +39,70 @@ class SingleColorEffect : public IEffect
       this->_color = color;
     }
 
+    //
+    // Supports changing the color in addition to
+    // the parameters supported by the base.
+    //
+    bool setParameter(uint8_t parameter, uint32_t value)
+    {
+      bool returnValue = true;
+
+      if (parameter == PARAMETER_COLOR)
+      {
+        this->_color = CRGB(value);
+      }
+      else
+      {
+        returnValue = IEffect::setParameter(parameter, value);
+      }
+
+      return returnValue;
+    }
+
+    //
+    // Turns off the LED that is lit before moving
+    // to the specified frame.
+    //
+    void seekFrame(uint64_t frame)
+    {
+      for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+      {
+        this->setLed(i, CRGB::Black);
+      }
+
+      IEffect::seekFrame(frame);
+    }
+
+    //
+    // Saves the color after the base state.
+    //
+    uint8_t saveState(uint8_t *state)
+    {
+      uint8_t length = IEffect::saveState(state);
+      memcpy(&state[length], &this->_color, sizeof(CRGB));
+      return length + sizeof(CRGB);
+    }
+
+    bool restoreState(const uint8_t *state, uint8_t length)
+    {
+      bool returnValue = false;
+
+      if (length >= EFFECT_BASE_STATE_LENGTH + sizeof(CRGB) && IEffect::restoreState(state, length))
+      {
+        memcpy(&this->_color, &state[EFFECT_BASE_STATE_LENGTH], sizeof(CRGB));
+        returnValue = true;
+      }
+
+      return returnValue;
+    }
+
   protected:
     bool onAnimate()
     {
       //
       // Set the previous LED to black (off).
       //
-      int64_t previousIndex = (this->_index - 1) % this->_numberOfLeds;
+      int64_t previousIndex = (this->_index + this->_numberOfLeds - 1) % this->_numberOfLeds;
       this->setLed(previousIndex, CRGB::Black);
 
       //
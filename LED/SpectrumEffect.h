@@ -0,0 +1,76 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "IEffect.h"
+#include "AudioAnalyzer.h"
+
+//
+// This animation effect displays the spectrum of an audio input.
+// The strip is divided into one section per frequency band, from
+// red for the lowest band to violet for the highest, and the
+// brightness of each section follows the level of its band. On a
+// beat the colors are washed out towards white.
+//
+class SpectrumEffect : public IEffect
+{
+  public:
+    //
+    // Initializes the effect:
+    //  leds:           The array of LEDs.
+    //  numberOfLeds:   Specifies the number of LEDs.
+    //  frameLength:    Specifies the length of time, in ms, to display a single frame.
+    //  analyzer:       The audio analyzer providing the band levels.
+    //
+    SpectrumEffect(CRGB *leds, uint32_t numberOfLeds, uint64_t frameLength, AudioAnalyzer *analyzer) : IEffect(leds, numberOfLeds, frameLength)
+    {
+      this->_analyzer = analyzer;
+    }
+
+  protected:
+    bool onAnimate()
+    {
+      //
+      // Only draw when there is a new analysis.
+      //
+      if (!this->_analyzer->update())
+      {
+        return false;
+      }
+
+      uint8_t numberOfBands = max(this->_analyzer->numberOfBands, (uint8_t)1);
+      uint8_t saturation = this->_analyzer->beat ? 96 : 255;
+
+      for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+      {
+        uint8_t band = (uint8_t)((i * numberOfBands) / this->_numberOfLeds);
+        uint8_t hue = (uint8_t)((band * 224) / numberOfBands);
+
+        this->_leds[i] = CHSV(hue, saturation, this->_analyzer->bands[band]);
+      }
+
+      //
+      // Return true since the animation was changed.
+      //
+      return true;
+    }
+
+  private:
+    AudioAnalyzer* _analyzer;
+};
@@ -19,6 +19,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "IEffect.h"
+#include "CHSL.h"
 
 //
 // This animation effect will cycle the entire strip
@@ -0,0 +1,184 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "SyncClock.h"
+
+//
+// Initialize the clock with the UDP instance, the address and
+// port used to share the time and the role of this controller.
+//
+SyncClock::SyncClock(UDP *udp, IPAddress address, uint16_t port, bool leader)
+{
+  this->_udp = udp;
+  this->_address = address;
+  this->_port = port;
+  this->leader = leader;
+};
+
+int64_t SyncClock::offset()
+{
+#ifndef ARDUINO
+  std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+#endif
+  int64_t returnValue = 0;
+
+  if (!this->leader && this->synchronized)
+  {
+    int64_t elapsed = (int64_t)(Clock::local() - this->_referenceLocal);
+    returnValue = this->_referenceOffset + ((elapsed * this->skew) / 1000000);
+  }
+
+  return returnValue;
+}
+
+uint64_t SyncClock::now()
+{
+#ifndef ARDUINO
+  std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+#endif
+  uint64_t returnValue = (uint64_t)((int64_t)Clock::local() + this->offset());
+
+  //
+  // A new estimate can move the time back slightly; hold the
+  // time until it catches up rather than going backwards. A
+  // large correction is made at once.
+  //
+  if (returnValue < this->_last && (this->_last - returnValue) <= SYNC_MAXIMUM_HOLD)
+  {
+    returnValue = this->_last;
+  }
+
+  this->_last = returnValue;
+
+  return returnValue;
+}
+
+void SyncClock::sample(uint64_t leaderTime, uint64_t localTime)
+{
+#ifndef ARDUINO
+  std::lock_guard<std::recursive_mutex> lock(this->_mutex);
+#endif
+  int64_t offset = (int64_t)(leaderTime - localTime);
+
+  //
+  // The first sample sets the clock right away.
+  //
+  if (!this->synchronized)
+  {
+    this->_referenceLocal = localTime;
+    this->_referenceOffset = offset;
+    this->synchronized = true;
+  }
+
+  //
+  // A delayed sample arrives late so its offset is lower; the
+  // highest offset in the window had the least delay.
+  //
+  if (this->_samples == 0 || offset > this->_bestOffset)
+  {
+    this->_bestOffset = offset;
+    this->_bestLocal = localTime;
+  }
+
+  this->_samples++;
+
+  if (this->_samples >= SYNC_WINDOW)
+  {
+    //
+    // The change in offset between windows is the skew.
+    //
+    if (this->_previous && this->_bestLocal > this->_previousLocal)
+    {
+      int64_t measured = ((this->_bestOffset - this->_previousOffset) * 1000000) / (int64_t)(this->_bestLocal - this->_previousLocal);
+      measured = constrain(measured, -SYNC_MAXIMUM_SKEW, SYNC_MAXIMUM_SKEW);
+
+      //
+      // Smooth the estimate.
+      //
+      this->skew += (int32_t)((measured - this->skew) / 4);
+    }
+
+    this->_previous = true;
+    this->_previousOffset = this->_bestOffset;
+    this->_previousLocal = this->_bestLocal;
+
+    this->_referenceLocal = this->_bestLocal;
+    this->_referenceOffset = this->_bestOffset;
+    this->_samples = 0;
+  }
+}
+
+bool SyncClock::update()
+{
+  bool returnValue = false;
+
+  if (this->leader)
+  {
+    uint64_t now = Clock::local();
+
+    if (this->_lastBroadcast == 0 || (now - this->_lastBroadcast) >= SYNC_INTERVAL)
+    {
+      uint8_t packet[SYNC_PACKET_LENGTH] = { 'L', 'S', SYNC_VERSION, 0 };
+
+      for (uint8_t i = 0; i < 8; i++)
+      {
+        packet[4 + i] = (uint8_t)(now >> (i * 8));
+      }
+
+      if (this->_udp->beginPacket(this->_address, this->_port))
+      {
+        this->_udp->write(packet, SYNC_PACKET_LENGTH);
+        returnValue = this->_udp->endPacket() == 1;
+      }
+
+      this->_lastBroadcast = now;
+    }
+  }
+  else
+  {
+    //
+    // Read every packet waiting so the samples are not
+    // delayed any more than necessary.
+    //
+    int size;
+
+    while ((size = this->_udp->parsePacket()) > 0)
+    {
+      uint64_t received = Clock::local();
+      uint8_t packet[SYNC_PACKET_LENGTH];
+
+      if (size == SYNC_PACKET_LENGTH && this->_udp->read(packet, SYNC_PACKET_LENGTH) == SYNC_PACKET_LENGTH &&
+          packet[0] == 'L' && packet[1] == 'S' && packet[2] == SYNC_VERSION)
+      {
+        uint64_t time = 0;
+
+        for (uint8_t i = 0; i < 8; i++)
+        {
+          time |= (uint64_t)packet[4 + i] << (i * 8);
+        }
+
+        this->sample(time, received);
+        returnValue = true;
+      }
+    }
+  }
+
+  return returnValue;
+}
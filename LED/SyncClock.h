@@ -0,0 +1,167 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef SYNC_CLOCK_H
+#define SYNC_CLOCK_H
+
+#include <Udp.h>
+#include "Clock.h"
+
+#ifndef ARDUINO
+#include <mutex>
+#endif
+
+//
+// The UDP port used to share the time.
+//
+#define SYNC_PORT           4049
+
+//
+// How often, in ms, the leader broadcasts the time.
+//
+#define SYNC_INTERVAL       1000
+
+//
+// The number of samples in each window. The sample that
+// arrived with the least delay in each window is used.
+//
+#define SYNC_WINDOW         8
+
+//
+// The largest skew, in parts per million, that will be
+// corrected. Ceramic resonators can be off by 0.5%.
+//
+#define SYNC_MAXIMUM_SKEW   10000
+
+//
+// The largest correction, in ms, that is made by holding the
+// time until it catches up (about the length of a frame). A
+// larger correction, such as the first sample when the leader
+// has been running for less time than this controller or after
+// the leader restarts, steps the time back at once; holding it
+// would stop the effects until the leader caught up.
+//
+#define SYNC_MAXIMUM_HOLD   50
+
+//
+// The sync packet: 'L', 'S', version, 0, time (uint64, little endian).
+//
+#define SYNC_PACKET_LENGTH  12
+#define SYNC_VERSION        1
+
+//
+// A clock shared by several controllers so that their effects
+// animate in lockstep. One controller is the leader and broadcasts
+// its time; the others (followers) adjust their clocks to match it.
+//
+// A follower estimates the offset between its clock and the leader's
+// from the sample in each window that arrived with the least delay
+// (network jitter only ever makes a sample late) and estimates the
+// skew (the difference in the rate of the clocks) from the change
+// in the offset between windows.
+//
+class SyncClock : public IClock
+{
+  public:
+    //
+    // Initializes the clock:
+    //  udp:            The UDP instance, already listening on the port.
+    //  address:        The broadcast (or multicast) address.
+    //  port:           The UDP port.
+    //  leader:         True if this controller is the leader.
+    //
+    SyncClock(UDP*, IPAddress, uint16_t, bool);
+
+    //
+    // Returns the shared time in ms. The time only goes
+    // backwards for a correction of more than
+    // SYNC_MAXIMUM_HOLD ms.
+    //
+    uint64_t now();
+
+    //
+    // The leader broadcasts the time when the interval has
+    // elapsed; followers read any time received. Call this
+    // from loop().
+    //
+    bool update();
+
+    //
+    // Adds a sample of the leader's time and the local time
+    // it was received. This is called by update() but can be
+    // used directly with another transport.
+    //
+    void sample(uint64_t leaderTime, uint64_t localTime);
+
+    //
+    // Returns the current estimated offset from the local
+    // clock to the leader's in ms.
+    //
+    int64_t offset();
+
+    //
+    // The estimated skew in parts per million.
+    //
+    int32_t skew = 0;
+
+    //
+    // True once a follower has received the leader's time.
+    //
+    bool synchronized = false;
+
+    bool leader = false;
+
+  protected:
+    UDP* _udp;
+    IPAddress _address;
+    uint16_t _port = SYNC_PORT;
+    uint64_t _lastBroadcast = 0;
+    uint64_t _last = 0;
+
+#ifndef ARDUINO
+    //
+    // On a host build the render engine reads the time from
+    // several threads while update() adds samples.
+    //
+    std::recursive_mutex _mutex;
+#endif
+
+    //
+    // The offset at the reference time; the skew is
+    // applied from there.
+    //
+    uint64_t _referenceLocal = 0;
+    int64_t _referenceOffset = 0;
+
+    //
+    // The current window.
+    //
+    uint8_t _samples = 0;
+    int64_t _bestOffset = 0;
+    uint64_t _bestLocal = 0;
+
+    //
+    // The best sample of the previous window.
+    //
+    bool _previous = false;
+    int64_t _previousOffset = 0;
+    uint64_t _previousLocal = 0;
+};
+#endif
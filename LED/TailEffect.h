@@ -19,6 +19,8 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "IEffect.h"
+#include "CHSL.h"
+#include "HdrBuffer.h"
 
 //
 // This animation will turn one LED on at a time using
@@ -43,6 +45,121 @@ class TailEffect : public IEffect
       this->_fadeFactor = fadeFactor;
     }
 
+    //
+    // Draws into a 16-bit buffer instead of the LED array so
+    // the dim end of the tail is not lost when it is reduced
+    // to 8 bits (see DitherOutput). NULL draws into the LED
+    // array.
+    //
+    void useBuffer(HdrBuffer* buffer)
+    {
+      this->_buffer = buffer;
+    }
+
+    //
+    // Clears the 16-bit buffer (the base clears the LED
+    // array) and then calls the base implementation.
+    //
+    bool reset()
+    {
+      if (this->_buffer != NULL)
+      {
+        this->_buffer->clear();
+      }
+
+      //
+      // Call the base reset.
+      //
+      return IEffect::reset();
+    }
+
+    //
+    // Clears the tail and moves its head to where it is
+    // at the specified frame.
+    //
+    void seekFrame(uint64_t frame)
+    {
+      if (this->_buffer != NULL)
+      {
+        this->_buffer->clear();
+      }
+      else
+      {
+        for (uint64_t i = 0; i < this->_numberOfLeds; i++)
+        {
+          this->setLed(i, CRGB::Black);
+        }
+      }
+
+      this->_index = frame % (this->_numberOfLeds + this->_tailLength + 1);
+    }
+
+    //
+    // Supports changing the color, tail length and fade
+    // factor in addition to the parameters supported by
+    // the base.
+    //
+    bool setParameter(uint8_t parameter, uint32_t value)
+    {
+      bool returnValue = true;
+
+      switch (parameter)
+      {
+        case PARAMETER_COLOR:
+          this->_color = CRGB(value);
+          break;
+        case PARAMETER_LENGTH:
+          this->_tailLength = value;
+          break;
+        case PARAMETER_FADE:
+          this->_fadeFactor = value / 1000.0;
+          break;
+        default:
+          returnValue = IEffect::setParameter(parameter, value);
+          break;
+      }
+
+      return returnValue;
+    }
+
+    //
+    // Saves the color, tail length and fade factor
+    // after the base state.
+    //
+    uint8_t saveState(uint8_t *state)
+    {
+      uint8_t length = IEffect::saveState(state);
+      uint16_t tailLength = (uint16_t)this->_tailLength;
+      float fadeFactor = (float)this->_fadeFactor;
+
+      memcpy(&state[length], &this->_color, sizeof(CRGB));
+      memcpy(&state[length + 3], &tailLength, sizeof(tailLength));
+      memcpy(&state[length + 5], &fadeFactor, sizeof(fadeFactor));
+
+      return length + 9;
+    }
+
+    bool restoreState(const uint8_t *state, uint8_t length)
+    {
+      bool returnValue = false;
+
+      if (length >= EFFECT_BASE_STATE_LENGTH + 9 && IEffect::restoreState(state, length))
+      {
+        uint16_t tailLength;
+        float fadeFactor;
+
+        memcpy(&this->_color, &state[EFFECT_BASE_STATE_LENGTH], sizeof(CRGB));
+        memcpy(&tailLength, &state[EFFECT_BASE_STATE_LENGTH + 3], sizeof(tailLength));
+        memcpy(&fadeFactor, &state[EFFECT_BASE_STATE_LENGTH + 5], sizeof(fadeFactor));
+
+        this->_tailLength = tailLength;
+        this->_fadeFactor = fadeFactor;
+        returnValue = true;
+      }
+
+      return returnValue;
+    }
+
   protected:
     bool onAnimate()
     {
@@ -60,7 +177,14 @@ class TailEffect : public IEffect
         //
         // Reset the LED color.
         //
-        this->setLed(i, CRGB::Black);
+        if (this->_buffer != NULL)
+        {
+          this->_buffer->setLed(i, CRGB16());
+        }
+        else
+        {
+          this->setLed(i, CRGB::Black);
+        }
       }
 
       //
@@ -78,7 +202,14 @@ class TailEffect : public IEffect
         //
         // Set the LED color.
         //
-        this->setLed(i, hsl.toRgb());
+        if (this->_buffer != NULL)
+        {
+          this->_buffer->setLed(i, hsl.toRgb16());
+        }
+        else
+        {
+          this->setLed(i, hsl.toRgb());
+        }
 
         //
         // Fade each subsequent LED in the tail.
@@ -101,4 +232,5 @@ class TailEffect : public IEffect
     uint64_t _tailLength = 0;
     double _fadeFactor = 0.0;
     CRGB _color = CRGB::White;
+    HdrBuffer* _buffer = NULL;
 };
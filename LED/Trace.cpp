@@ -0,0 +1,337 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Trace.h"
+
+#ifndef ARDUINO
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+static std::recursive_mutex _traceMutex;
+#define TRACE_LOCK()        std::lock_guard<std::recursive_mutex> _traceLock(_traceMutex)
+
+//
+// The events a thread has recorded in the current pass through
+// loop(). Only endFrame() and begin() take another thread's
+// events, so the lock is rarely contended.
+//
+struct TraceThread
+{
+  TraceThread();
+  ~TraceThread();
+
+  std::mutex mutex;
+  TraceEvent pending[TRACE_PENDING];
+  uint8_t count = 0;
+  uint8_t id = 0;
+};
+
+//
+// Every thread that has recorded an event, guarded by
+// _traceMutex.
+//
+static std::vector<TraceThread*> _traceThreads;
+static uint8_t _traceNextThread = 0;
+static thread_local TraceThread _traceThread;
+
+TraceThread::TraceThread()
+{
+  TRACE_LOCK();
+  this->id = _traceNextThread++;
+  _traceThreads.push_back(this);
+}
+
+//
+// Deconstructor: the events of a thread that has ended
+// are not kept.
+//
+TraceThread::~TraceThread()
+{
+  TRACE_LOCK();
+  _traceThreads.erase(std::find(_traceThreads.begin(), _traceThreads.end(), this));
+}
+#else
+#define TRACE_LOCK()
+#endif
+
+//
+// The Cortex-M3, M4 and M7 have a cycle counter in the
+// Data Watchpoint and Trace (DWT) unit.
+//
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define TRACE_CYCLE_COUNTER
+#define TRACE_DEMCR         (*(volatile uint32_t*)0xE000EDFC)
+#define TRACE_DWT_CTRL      (*(volatile uint32_t*)0xE0001000)
+#define TRACE_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004)
+#endif
+
+#ifdef ARDUINO
+TraceEvent Trace::_pending[TRACE_PENDING];
+uint8_t Trace::_pendingCount = 0;
+#endif
+TraceEvent Trace::_events[TRACE_EVENTS];
+uint16_t Trace::_next = 0;
+uint16_t Trace::_count = 0;
+uint32_t Trace::_ticksPerSecond = 0;
+
+static const char* const TRACE_NAMES[TRACE_PHASES] = { "buttons", "control", "readyToAnimate", "onAnimate", "post", "show", "save", "late" };
+
+void Trace::begin()
+{
+#if defined(TRACE_CYCLE_COUNTER)
+  //
+  // Enable trace and then the cycle counter.
+  //
+  TRACE_DEMCR |= (1UL << 24);
+  TRACE_DWT_CYCCNT = 0;
+  TRACE_DWT_CTRL |= 1UL;
+#endif
+
+  TRACE_LOCK();
+#ifdef ARDUINO
+  Trace::_pendingCount = 0;
+#else
+  for (TraceThread* thread : _traceThreads)
+  {
+    std::lock_guard<std::mutex> lock(thread->mutex);
+    thread->count = 0;
+  }
+#endif
+  Trace::_next = 0;
+  Trace::_count = 0;
+  Trace::_ticksPerSecond = Trace::ticksPerSecond();
+}
+
+uint32_t Trace::ticks()
+{
+#if defined(TRACE_CYCLE_COUNTER)
+  return TRACE_DWT_CYCCNT;
+#elif defined(ARDUINO)
+  return micros();
+#else
+  //
+  // Microseconds, like micros(), so the 32-bit count only
+  // wraps every 71 minutes.
+  //
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint32_t Trace::ticksPerSecond()
+{
+#if defined(TRACE_CYCLE_COUNTER) && defined(F_CPU)
+  return F_CPU;
+#elif defined(TRACE_CYCLE_COUNTER)
+  return SystemCoreClock;
+#else
+  return 1000000UL;
+#endif
+}
+
+void Trace::record(uint8_t phase, uint32_t start, uint32_t duration)
+{
+#ifdef ARDUINO
+  TraceEvent* pending = Trace::_pending;
+  uint8_t& count = Trace::_pendingCount;
+  uint8_t id = 0;
+#else
+  TraceThread& thread = _traceThread;
+  std::lock_guard<std::mutex> lock(thread.mutex);
+  TraceEvent* pending = thread.pending;
+  uint8_t& count = thread.count;
+  uint8_t id = thread.id;
+#endif
+
+  if (count < TRACE_PENDING)
+  {
+    TraceEvent* event = &pending[count++];
+    event->start = start;
+    event->duration = duration;
+    event->phase = phase;
+    event->thread = id;
+  }
+}
+
+void Trace::endFrame(bool keep)
+{
+  TRACE_LOCK();
+
+#ifdef ARDUINO
+  if (keep)
+  {
+    for (uint8_t i = 0; i < Trace::_pendingCount; i++)
+    {
+      Trace::store(Trace::_pending[i]);
+    }
+  }
+
+  Trace::_pendingCount = 0;
+#else
+  for (TraceThread* thread : _traceThreads)
+  {
+    std::lock_guard<std::mutex> lock(thread->mutex);
+
+    if (keep)
+    {
+      for (uint8_t i = 0; i < thread->count; i++)
+      {
+        Trace::store(thread->pending[i]);
+      }
+    }
+
+    thread->count = 0;
+  }
+#endif
+}
+
+void Trace::store(const TraceEvent &event)
+{
+  Trace::_events[Trace::_next] = event;
+  Trace::_next = (Trace::_next + 1) % TRACE_EVENTS;
+
+  if (Trace::_count < TRACE_EVENTS)
+  {
+    Trace::_count++;
+  }
+}
+
+uint16_t Trace::count()
+{
+  return Trace::_count;
+}
+
+const TraceEvent& Trace::event(uint16_t index)
+{
+  //
+  // The oldest event is the next one to be overwritten
+  // once the buffer is full.
+  //
+  return Trace::_events[(Trace::_next + TRACE_EVENTS - Trace::_count + index) % TRACE_EVENTS];
+}
+
+void Trace::dump(Print& output)
+{
+  TRACE_LOCK();
+  uint32_t ticksPerSecond = Trace::_ticksPerSecond != 0 ? Trace::_ticksPerSecond : Trace::ticksPerSecond();
+  uint8_t header[TRACE_HEADER_LENGTH] = { 'T', 'R', TRACE_VERSION, 0,
+                                          (uint8_t)Trace::_count, (uint8_t)(Trace::_count >> 8),
+                                          (uint8_t)ticksPerSecond, (uint8_t)(ticksPerSecond >> 8),
+                                          (uint8_t)(ticksPerSecond >> 16), (uint8_t)(ticksPerSecond >> 24) };
+
+  output.write(header, TRACE_HEADER_LENGTH);
+
+  for (uint16_t i = 0; i < Trace::_count; i++)
+  {
+    const TraceEvent& event = Trace::event(i);
+    uint8_t data[TRACE_EVENT_LENGTH] = { (uint8_t)event.start, (uint8_t)(event.start >> 8),
+                                         (uint8_t)(event.start >> 16), (uint8_t)(event.start >> 24),
+                                         (uint8_t)event.duration, (uint8_t)(event.duration >> 8),
+                                         (uint8_t)(event.duration >> 16), (uint8_t)(event.duration >> 24),
+                                         event.phase, event.thread };
+
+    output.write(data, TRACE_EVENT_LENGTH);
+  }
+}
+
+#ifndef ARDUINO
+static uint32_t traceReadUInt32(const uint8_t* data)
+{
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+bool Trace::load(const uint8_t* data, uint32_t length)
+{
+  TRACE_LOCK();
+  bool returnValue = false;
+
+  if (length >= TRACE_HEADER_LENGTH && data[0] == 'T' && data[1] == 'R' && data[2] == TRACE_VERSION)
+  {
+    uint16_t count = (uint16_t)data[4] | ((uint16_t)data[5] << 8);
+
+    if (count <= TRACE_EVENTS && length >= TRACE_HEADER_LENGTH + ((uint32_t)count * TRACE_EVENT_LENGTH))
+    {
+      Trace::_next = 0;
+      Trace::_count = 0;
+      Trace::_ticksPerSecond = traceReadUInt32(data + 6);
+
+      for (uint16_t i = 0; i < count; i++)
+      {
+        const uint8_t* event = data + TRACE_HEADER_LENGTH + (i * TRACE_EVENT_LENGTH);
+        TraceEvent loaded = { traceReadUInt32(event), traceReadUInt32(event + 4), event[8], event[9] };
+        Trace::store(loaded);
+      }
+
+      returnValue = true;
+    }
+  }
+
+  return returnValue;
+}
+
+void Trace::writeChrome(FILE* file)
+{
+  TRACE_LOCK();
+  uint32_t ticksPerSecond = Trace::_ticksPerSecond != 0 ? Trace::_ticksPerSecond : Trace::ticksPerSecond();
+  double ticksPerMicrosecond = ticksPerSecond / 1000000.0;
+
+  //
+  // The 32-bit tick counter wraps; the difference from the
+  // previous start unwraps it. Events are recorded as they end
+  // so an enclosing scope starts a little before the event
+  // recorded ahead of it: a difference that is less than a
+  // second back is taken as negative, anything else (including
+  // a long gap between kept frames) as forward.
+  //
+  int64_t time = 0;
+  uint32_t previous = Trace::_count > 0 ? Trace::event(0).start : 0;
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+  for (uint16_t i = 0; i < Trace::_count; i++)
+  {
+    const TraceEvent& event = Trace::event(i);
+    const char* name = event.phase < TRACE_PHASES ? TRACE_NAMES[event.phase] : "unknown";
+
+    uint32_t difference = event.start - previous;
+    time += (0U - difference) <= ticksPerSecond ? -(int64_t)(0U - difference) : (int64_t)difference;
+    previous = event.start;
+
+    if (i > 0)
+    {
+      fprintf(file, ",");
+    }
+
+    if (event.phase == TRACE_LATE)
+    {
+      fprintf(file, "\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"ms\":%u}}",
+              name, time / ticksPerMicrosecond, event.thread + 1U, (unsigned)event.duration);
+    }
+    else
+    {
+      fprintf(file, "\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+              name, time / ticksPerMicrosecond, event.duration / ticksPerMicrosecond, event.thread + 1U);
+    }
+  }
+
+  fprintf(file, "\n]}\n");
+}
+#endif
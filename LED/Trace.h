@@ -0,0 +1,228 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <FastLED.h>
+
+#ifndef ARDUINO
+#include <cstdio>
+#endif
+
+//
+// Uncomment to record a trace of each pass through loop(). The
+// define must be here (rather than in the sketch) so it applies
+// to every file.
+//
+// #define LED_TRACE
+
+//
+// The number of events kept; the oldest are overwritten.
+//
+#ifndef TRACE_EVENTS
+#if defined(__AVR__)
+#define TRACE_EVENTS        32
+#else
+#define TRACE_EVENTS        256
+#endif
+#endif
+
+//
+// The number of events that can be held for one pass through
+// loop(). On a host build this is for each thread.
+//
+#ifndef TRACE_PENDING
+#if defined(ARDUINO)
+#define TRACE_PENDING       8
+#else
+#define TRACE_PENDING       64
+#endif
+#endif
+
+//
+// The phases of a frame.
+//
+#define TRACE_BUTTONS       0
+#define TRACE_CONTROL       1
+#define TRACE_READY         2
+#define TRACE_ANIMATE       3
+#define TRACE_POST          4
+#define TRACE_SHOW          5
+#define TRACE_SAVE          6
+
+//
+// An instant event recorded when a frame starts late; the
+// value is how late it was in ms.
+//
+#define TRACE_LATE          7
+
+#define TRACE_PHASES        8
+
+//
+// The binary dump: 'T', 'R', version, 0, event count (uint16),
+// ticks per second (uint32), then each event: start (uint32),
+// duration (uint32), phase, thread. Values are little endian.
+//
+#define TRACE_VERSION       2
+#define TRACE_HEADER_LENGTH 10
+#define TRACE_EVENT_LENGTH  10
+
+//
+// A recorded event. Times are in ticks of Trace::ticks().
+//
+struct TraceEvent
+{
+  uint32_t start;
+  uint32_t duration;
+  uint8_t phase;
+
+  //
+  // The thread that recorded the event: always 0 on a board;
+  // on the host threads are numbered as they first record.
+  //
+  uint8_t thread;
+};
+
+//
+// Records how long each phase of a frame takes into a ring
+// buffer so that the frame budget can be examined. Ticks are
+// CPU cycles on Cortex-M3 and above and microseconds on other
+// boards and the host.
+//
+// On a host build the render engine's threads record events too.
+// Each thread records into its own pending events, so the threads
+// do not wait for each other, and endFrame() collects them all.
+//
+class Trace
+{
+  public:
+    //
+    // Enables the cycle counter and clears the events.
+    //
+    static void begin();
+
+    //
+    // Returns the current time in ticks.
+    //
+    static uint32_t ticks();
+
+    //
+    // Returns the number of ticks per second.
+    //
+    static uint32_t ticksPerSecond();
+
+    //
+    // Records an event for the current pass through loop().
+    //
+    static void record(uint8_t phase, uint32_t start, uint32_t duration);
+
+    //
+    // Ends a pass through loop(). Most passes do not draw a
+    // frame, so their events are only kept when keep is true.
+    //
+    static void endFrame(bool keep);
+
+    //
+    // Returns the number of events held (at most TRACE_EVENTS).
+    //
+    static uint16_t count();
+
+    //
+    // Returns an event; 0 is the oldest.
+    //
+    static const TraceEvent& event(uint16_t index);
+
+    //
+    // Writes the events in the compact binary format.
+    //
+    static void dump(Print& output);
+
+#ifndef ARDUINO
+    //
+    // Replaces the events with those in a binary dump (for
+    // example one captured from a controller's serial port).
+    //
+    static bool load(const uint8_t* data, uint32_t length);
+
+    //
+    // Writes the events as Chrome trace JSON, which can be
+    // opened in chrome://tracing or Perfetto. Each thread is
+    // shown on its own track.
+    //
+    static void writeChrome(FILE* file);
+#endif
+
+  protected:
+    //
+    // Adds an event to the ring buffer.
+    //
+    static void store(const TraceEvent& event);
+
+#ifdef ARDUINO
+    static TraceEvent _pending[TRACE_PENDING];
+    static uint8_t _pendingCount;
+#endif
+    static TraceEvent _events[TRACE_EVENTS];
+    static uint16_t _next;
+    static uint16_t _count;
+    static uint32_t _ticksPerSecond;
+};
+
+//
+// Records the time from its creation to the end of the scope.
+//
+class TraceScope
+{
+  public:
+    inline TraceScope(uint8_t phase)
+    {
+      this->_phase = phase;
+      this->_start = Trace::ticks();
+    }
+
+    inline ~TraceScope()
+    {
+      Trace::record(this->_phase, this->_start, Trace::ticks() - this->_start);
+    }
+
+  protected:
+    uint8_t _phase;
+    uint32_t _start;
+};
+
+//
+// The trace macros compile to nothing unless LED_TRACE
+// is defined.
+//
+#ifdef LED_TRACE
+#define TRACE_JOIN2(a, b)           a##b
+#define TRACE_JOIN(a, b)            TRACE_JOIN2(a, b)
+#define TRACE_BEGIN()               Trace::begin()
+#define TRACE_SCOPE(phase)          TraceScope TRACE_JOIN(_traceScope, __LINE__)(phase)
+#define TRACE_EVENT(phase, value)   Trace::record(phase, Trace::ticks(), value)
+#define TRACE_END_FRAME(keep)       Trace::endFrame(keep)
+#else
+#define TRACE_BEGIN()
+#define TRACE_SCOPE(phase)
+#define TRACE_EVENT(phase, value)
+#define TRACE_END_FRAME(keep)       (void)(keep)
+#endif
+#endif
@@ -0,0 +1,156 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "WavSource.h"
+
+#ifndef ARDUINO
+#include <cstring>
+
+WavSource::WavSource()
+{
+};
+
+//
+// Deconstructor: close the file.
+//
+WavSource::~WavSource()
+{
+  this->close();
+};
+
+bool WavSource::open(const char *path)
+{
+  this->close();
+  this->_file = fopen(path, "rb");
+
+  if (this->_file == NULL)
+  {
+    return false;
+  }
+
+  uint8_t riff[12];
+
+  if (fread(riff, 1, sizeof(riff), this->_file) != sizeof(riff) || memcmp(riff, "RIFF", 4) != 0 || memcmp(&riff[8], "WAVE", 4) != 0)
+  {
+    this->close();
+    return false;
+  }
+
+  //
+  // Walk the chunks reading the format and stopping
+  // at the start of the data.
+  //
+  bool format = false;
+  uint8_t header[8];
+
+  while (fread(header, 1, sizeof(header), this->_file) == sizeof(header))
+  {
+    uint32_t length = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+
+    if (memcmp(header, "fmt ", 4) == 0 && length >= 16)
+    {
+      uint8_t fmt[16];
+
+      if (fread(fmt, 1, sizeof(fmt), this->_file) != sizeof(fmt))
+      {
+        break;
+      }
+
+      uint16_t audioFormat = fmt[0] | (fmt[1] << 8);
+      uint16_t bitsPerSample = fmt[14] | (fmt[15] << 8);
+      this->channels = fmt[2] | (fmt[3] << 8);
+      this->sampleRate = fmt[4] | (fmt[5] << 8) | (fmt[6] << 16) | ((uint32_t)fmt[7] << 24);
+      format = audioFormat == 1 && bitsPerSample == 16 && this->channels > 0;
+
+      fseek(this->_file, (length - 16) + (length & 1), SEEK_CUR);
+    }
+    else if (memcmp(header, "data", 4) == 0)
+    {
+      if (format)
+      {
+        this->_remaining = length / (2 * this->channels);
+        return true;
+      }
+
+      break;
+    }
+    else
+    {
+      //
+      // Chunks are padded to an even length.
+      //
+      fseek(this->_file, length + (length & 1), SEEK_CUR);
+    }
+  }
+
+  this->close();
+  return false;
+}
+
+void WavSource::close()
+{
+  if (this->_file != NULL)
+  {
+    fclose(this->_file);
+    this->_file = NULL;
+  }
+
+  this->_remaining = 0;
+}
+
+uint32_t WavSource::feed(AudioInput *input, uint32_t count)
+{
+  uint32_t returnValue = 0;
+  uint16_t channels = this->channels < 8 ? this->channels : 8;
+  uint32_t skip = (uint32_t)(this->channels - channels) * 2;
+
+  while (this->_file != NULL && returnValue < count && this->_remaining > 0)
+  {
+    uint8_t bytes[16];
+
+    if (fread(bytes, 2, channels, this->_file) != channels)
+    {
+      this->_remaining = 0;
+      break;
+    }
+
+    if (skip > 0)
+    {
+      fseek(this->_file, skip, SEEK_CUR);
+    }
+
+    //
+    // Mix the channels (little endian) down to one.
+    //
+    int32_t sum = 0;
+
+    for (uint16_t c = 0; c < channels; c++)
+    {
+      sum += (int16_t)(bytes[c * 2] | (bytes[(c * 2) + 1] << 8));
+    }
+
+    input->push((int16_t)(sum / channels));
+    this->_remaining--;
+    returnValue++;
+  }
+
+  return returnValue;
+}
+#endif
@@ -0,0 +1,67 @@
+/*
+   The MIT License (MIT)
+
+   Copyright © 2022 Daniel Porrey
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+   and associated documentation files (the “Software”), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all copies or substantial
+   portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+   WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef WAV_SOURCE_H
+#define WAV_SOURCE_H
+
+//
+// Reading WAV files is only available on a host build where
+// it replaces the ADC as the source of audio samples.
+//
+#ifndef ARDUINO
+#include <cstdio>
+#include "AudioInput.h"
+
+//
+// Reads 16-bit PCM samples from a WAV file and pushes them into
+// an audio input, mixing multiple channels down to one.
+//
+class WavSource
+{
+  public:
+    WavSource();
+    ~WavSource();
+
+    //
+    // Opens the file and reads its header. Returns false if the
+    // file cannot be opened or is not 16-bit PCM.
+    //
+    bool open(const char* path);
+
+    //
+    // Closes the file.
+    //
+    void close();
+
+    //
+    // Pushes up to count samples into the input. Returns the
+    // number of samples pushed; 0 at the end of the file.
+    //
+    uint32_t feed(AudioInput* input, uint32_t count);
+
+    uint32_t sampleRate = 0;
+    uint16_t channels = 0;
+
+  protected:
+    FILE* _file = NULL;
+    uint32_t _remaining = 0;
+};
+#endif
+#endif
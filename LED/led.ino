@@ -19,6 +19,10 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "IEffect.h"
+#include "FastLedOutput.h"
+#include "ControlPort.h"
+#include "Persistence.h"
+#include "Trace.h"
 #include <AceButton.h>
 using namespace ace_button;
 
@@ -47,6 +51,20 @@ using namespace ace_button;
 #define LED_PIN_7        8
 #define LED_PIN_8        9
 
+//
+// The maximum number of bytes read from the control port
+// on each pass through loop().
+//
+#define CONTROL_BYTES_PER_LOOP  32
+
+//
+// The EEPROM address and number of slots used to save
+// the current effect. The more slots, the longer the
+// EEPROM lasts; the ring uses all of it by default.
+//
+#define PERSISTENCE_ADDRESS     0
+#define PERSISTENCE_SLOTS       PERSISTENCE_ALL_SLOTS
+
 //
 // Define the pins assigned to each button.
 //
@@ -76,6 +94,12 @@ IEffect* _effect4 = new TailEffect(_leds, LED_COUNT, 100, CRGB(0, 24, 210), 4, .
 //
 IEffect* _effects[] = { _effect1, _effect2, _effect3, _effect4 };
 
+//
+// Define the output used to display the LEDs. Replace this with
+// a DdpOutput to send the LEDs to a network pixel controller.
+//
+IOutput* _output = new FastLedOutput(_leds, LED_COUNT);
+
 //
 // Using the AceButton library, define the 4 buttons.
 //
@@ -91,6 +115,27 @@ AceButton _button4(BUTTON_PIN_4);
 //
 void handleEvent(AceButton*, uint8_t, uint8_t);
 
+//
+// The control port receives commands over the serial port.
+// The buffer is large enough for a full frame of LEDs.
+//
+ControlPort _control(&Serial, (LED_COUNT * 3) + 5);
+
+//
+// Forward reference for the control port command handler.
+//
+void handleCommand(uint8_t, const uint8_t*, uint16_t);
+
+#ifdef LED_TRACE
+void sendTrace();
+#endif
+
+//
+// Saves the current effect and its state so that it
+// can be restored after a power loss.
+//
+Persistence _persistence(PERSISTENCE_ADDRESS, PERSISTENCE_SLOTS);
+
 //
 // Keep track of the current effect. This is the index
 // to the effects array which selects the current animation.
@@ -108,19 +153,27 @@ bool _isOn = true;
 //
 bool _reset = false;
 
+//
+// Create a flag to indicate that frames are being streamed
+// over the control port. The current effect is paused
+// while streaming.
+//
+bool _streaming = false;
+
 void setup()
 {
   //
-  // Set up the serial port for debugging.
+  // Set up the serial port for debugging. The sketch does not
+  // wait for the serial port to connect so that the LEDs start
+  // as quickly as possible.
   //
   Serial.begin(115200);
-  delay(250);
+  Serial.println("Serial port initialized.");
 
   //
-  // Wait for serial port to connect.
+  // Start the trace (only when LED_TRACE is defined in Trace.h).
   //
-  while (!Serial) {}
-  Serial.println("Serial port initialized.");
+  TRACE_BEGIN();
 
   //
   // Add the LEDs for each strip.
@@ -135,6 +188,25 @@ void setup()
   FastLED.addLeds<WS2812, LED_PIN_8, GRB>(_leds, LED_COUNT);
   Serial.println("FastLED initialization complete.");
 
+  //
+  // Restore the effect that was running when the power was
+  // lost, or reset the default effect, and draw the first
+  // frame right away.
+  //
+  if (_persistence.restore(_effects, sizeof(_effects) / sizeof(_effects[0]), &_currentEffect))
+  {
+    Serial.print("Restored Effect Index "); Serial.println(_currentEffect);
+  }
+  else
+  {
+    _effects[_currentEffect]->reset();
+  }
+
+  if (_effects[_currentEffect]->animate())
+  {
+    _output->show();
+  }
+
   //
   // Initialize the buttons using an internal pull-up. This allows the button
   // to be connected directly between the data pin and ground.
@@ -172,9 +244,9 @@ void setup()
   Serial.println("Button handler initialization complete.");
 
   //
-  // Call reset on the default effect.
+  // Handle commands received on the control port.
   //
-  _effects[_currentEffect]->reset();
+  _control.setCommandHandler(handleCommand);
 
   uint64_t minimumFrameLength = (30 * LED_COUNT) + 50;
   Serial.print("The minimum frame length for "); Serial.print((float) LED_COUNT); Serial.print(" LEDs is "); Serial.print((float)minimumFrameLength, 0); Serial.println(" µs.");
@@ -182,18 +254,32 @@ void setup()
 
 void loop()
 {
+  bool drawn = false;
+
   //
   // Check the state of each button.
   //
-  _button1.check();
-  _button2.check();
-  _button3.check();
-  _button4.check();
+  {
+    TRACE_SCOPE(TRACE_BUTTONS);
+    _button1.check();
+    _button2.check();
+    _button3.check();
+    _button4.check();
+  }
+
+  //
+  // Process a limited number of bytes from the control
+  // port so the animation timing is not affected.
+  //
+  {
+    TRACE_SCOPE(TRACE_CONTROL);
+    _control.poll(CONTROL_BYTES_PER_LOOP);
+  }
 
   //
   // Check the current state.
   //
-  if (_isOn && !_reset)
+  if (_isOn && !_reset && !_streaming)
   {
     //
     // Animate the current effect. If a change has been made the
@@ -204,9 +290,33 @@ void loop()
       //
       // Draw the current LEDs.
       //
-      FastLED.show();
+      TRACE_SCOPE(TRACE_SHOW);
+      _output->show();
+      drawn = true;
+    }
+    else
+    {
+      //
+      // Let the output update the LEDs between frames (for
+      // example to advance the dither of a DitherOutput).
+      //
+      TRACE_SCOPE(TRACE_SHOW);
+      drawn = _output->refresh();
+    }
+
+    //
+    // Save the current effect if it has changed.
+    //
+    {
+      TRACE_SCOPE(TRACE_SAVE);
+      _persistence.update(_currentEffect, _effects[_currentEffect]);
     }
   }
+
+  //
+  // Only passes that drew a frame are kept in the trace.
+  //
+  TRACE_END_FRAME(drawn);
 }
 
 //
@@ -261,6 +371,14 @@ void handleEvent(AceButton* button, uint8_t eventType, uint8_t /* buttonState */
       {
         FastLED.clear();
         FastLED.show();
+
+#ifdef LED_TRACE
+        //
+        // Nothing is animating so sending the trace will
+        // not affect it.
+        //
+        sendTrace();
+#endif
       }
       break;
 
@@ -303,7 +421,109 @@ void handleEvent(AceButton* button, uint8_t eventType, uint8_t /* buttonState */
       //
       _reset = false;
 
+      //
+      // Save the new effect.
+      //
+      _persistence.changed();
+
       Serial.print("Current Effect Index is "); Serial.println(_currentEffect);
       break;
   }
 }
+
+//
+// This handler will be called with each command received
+// on the control port.
+//
+void handleCommand(uint8_t command, const uint8_t* payload, uint16_t length)
+{
+  switch (command)
+  {
+    case CONTROL_SELECT_EFFECT:
+      //
+      // Select and restart an effect; this ends streaming.
+      //
+      if (length >= 1 && payload[0] < (sizeof(_effects) / sizeof(_effects[0])))
+      {
+        _currentEffect = payload[0];
+        _effects[_currentEffect]->reset();
+        _streaming = false;
+        _reset = false;
+        _persistence.changed();
+      }
+      break;
+
+    case CONTROL_SET_PARAMETER:
+      //
+      // Change a parameter of the current effect. A new length
+      // only takes effect after a reset (as it does when the
+      // sequencer sets it before starting a cue).
+      //
+      if (length >= 5)
+      {
+        uint32_t value = (uint32_t)payload[1] | ((uint32_t)payload[2] << 8) | ((uint32_t)payload[3] << 16) | ((uint32_t)payload[4] << 24);
+        if (_effects[_currentEffect]->setParameter(payload[0], value))
+        {
+          if (payload[0] == PARAMETER_LENGTH)
+          {
+            _effects[_currentEffect]->reset();
+          }
+
+          _persistence.changed();
+        }
+      }
+      break;
+
+    case CONTROL_FRAME:
+      //
+      // Copy the LEDs into the LED array; the effect is
+      // paused until an effect is selected again.
+      //
+      if (length >= 2)
+      {
+        uint16_t first = (uint16_t)payload[0] | ((uint16_t)payload[1] << 8);
+
+        for (uint16_t i = 2; i + 2 < length && first < LED_COUNT; i += 3, first++)
+        {
+          _leds[first] = CRGB(payload[i], payload[i + 1], payload[i + 2]);
+        }
+
+        _streaming = true;
+      }
+      break;
+
+    case CONTROL_SHOW:
+      //
+      // Display the streamed frame.
+      //
+      if (_isOn)
+      {
+        _output->show();
+      }
+      break;
+
+#ifdef LED_TRACE
+    case CONTROL_TRACE:
+      //
+      // Send the trace; the frames drawn while it is sent
+      // will be late.
+      //
+      sendTrace();
+      break;
+#endif
+  }
+}
+
+#ifdef LED_TRACE
+//
+// Sends the trace over the control port. The binary dump has 0
+// bytes in it, which end a frame, so it is sent as the payload
+// of CONTROL_TRACE replies rather than written to the port.
+//
+void sendTrace()
+{
+  ControlWriter writer(&_control, CONTROL_TRACE);
+  Trace::dump(writer);
+  writer.end();
+}
+#endif